@@ -1,7 +1,1077 @@
 #include "BigDecimal.h"
 
+#include <bit>
+#include <charconv>
+#include <cctype>
+#include <cfloat>
+#include <cstdlib>
+#include <limits>
+
+
+namespace
+{
+    thread_local DecimalContext context;
+
+    // From this many digits on, quotients come from a Newton reciprocal instead of a long division
+    constexpr std::size_t DIV_NEWTON_DIGITS = 1000;
+
+    // Digits of a double precision seed that a first Newton step may rely on
+    constexpr std::size_t SEED_DIGITS = 12;
+
+    // Digits carried beyond the requested precision by correctly rounded Newton results; the approximation
+    // then decides the rounding except within 10^-6 units of a boundary
+    constexpr std::size_t NEWTON_GUARD = 8;
+
+
+    std::size_t length(const BigInteger &m) {
+        return static_cast<std::size_t>(Length(m));
+    }
+
+    // Whether dropping digits that start with `first`, followed by a nonzero tail if `sticky`,
+    // rounds the kept magnitude (whose last digit is odd if `odd`) up by one unit
+    bool round_up(BigDecimal::Rounding mode, int first, bool sticky, bool odd, bool negative)
+    {
+        const bool inexact = first || sticky;
+
+        switch (mode)
+        {
+            case BigDecimal::Rounding::HALF_EVEN:
+                return first > 5 || (first == 5 && (sticky || odd));
+            case BigDecimal::Rounding::HALF_UP:
+                return first >= 5;
+            case BigDecimal::Rounding::HALF_DOWN:
+                return first > 5 || (first == 5 && sticky);
+            case BigDecimal::Rounding::DOWN:
+                return false;
+            case BigDecimal::Rounding::UP:
+                return inexact;
+            case BigDecimal::Rounding::FLOOR:
+                return inexact && negative;
+            case BigDecimal::Rounding::CEILING:
+                return inexact && !negative;
+        }
+        return false;
+    }
+
+    // Significant bits of a double
+    constexpr int DOUBLE_BITS = DBL_MANT_DIG;
+
+    // Decimal digits of the mantissa that fit a uint64_t
+    constexpr std::size_t TOP_LIMB_DIGITS = 19;
+
+    // The largest power of ten that a double holds exactly
+    constexpr int64_t EXACT_POW10 = 22;
+
+    // Halfway points between doubles have at most 767 significant digits, so the digits of a mantissa beyond
+    // this many only matter through being nonzero
+    constexpr std::size_t EXACT_DIGITS = 800;
+
+    // Powers of five kept for the conversion of doubles; 5^k for k up to this covers |d| >= 2^-75
+    constexpr int64_t CACHED_POWERS_OF_FIVE = 128;
+
+    BigInteger power_of_five(int64_t k)
+    {
+        static const std::vector<BigInteger> powers = [] {
+            std::vector<BigInteger> p(CACHED_POWERS_OF_FIVE + 1, BigConstants::ONE);
+
+            for (std::size_t i = 1; i < p.size(); ++i) {
+                p[i] = p[i - 1] * BigConstants::FIVE;
+            }
+            return p;
+        }();
+        return (k <= CACHED_POWERS_OF_FIVE ? powers[static_cast<std::size_t>(k)] : BigConstants::FIVE ^ BigInteger(k));
+    }
+
+    double power_of_ten(int64_t k)
+    {
+        static const double powers[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        return powers[k];
+    }
+
+    // Rounds (q + f) * 2^b to the nearest double, ties to even, for q >= 2^55 and 0 <= f < 1 nonzero if `sticky`
+    double round_to_double(uint64_t q, int64_t b, bool sticky)
+    {
+        const int64_t len = std::bit_width(q);
+
+        // Normal results keep DOUBLE_BITS bits; subnormal ones keep those down to 2^-1074
+        const int64_t drop = (b + len - 1 >= DBL_MIN_EXP - 1 ? len - DOUBLE_BITS : DBL_MIN_EXP - DOUBLE_BITS - b);
+
+        uint64_t kept = 0;
+        bool up;
+
+        if (drop >= 64)
+            up = (drop == 64 && (q > (uint64_t(1) << 63) || (q == (uint64_t(1) << 63) && sticky)));
+        else
+        {
+            const uint64_t half = uint64_t(1) << (drop - 1);
+            const uint64_t rest = q & ((half << 1) - 1);
+
+            kept = q >> drop;
+            up = rest > half || (rest == half && (sticky || (kept & 1)));
+        }
+        // ldexp overflows to infinity
+        return std::ldexp(static_cast<double>(kept + up), static_cast<int>(b + drop));
+    }
+
+    /*
+     * Tries (w + tail) * 10^k, with 0 <= tail < 1 nonzero if `inexact`, in long double arithmetic. The result
+     * stands when the estimate lies clearly inside the interval of numbers rounding to the same double;
+     * otherwise, and where long double has no more bits than double, the caller converts exactly.
+     */
+    bool decided_by_top_limb(uint64_t w, int64_t k, bool inexact, double &result)
+    {
+        using limits = std::numeric_limits<long double>;
+
+        if (limits::digits < 64) {
+            return false;
+        }
+        // Powers of ten up to 10^27 are exact in 64 bits; each further factor rounds once
+        static const long double powers[] = {
+                1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L, 1e10L, 1e11L, 1e12L, 1e13L,
+                1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+        };
+        int64_t n = (k < 0 ? -k : k);
+        int roundings = 2;
+
+        long double scale = 1;
+
+        for (; n > 27; n -= 27, ++roundings) {
+            scale *= powers[27];
+        }
+        scale *= powers[n];
+
+        const auto w_l = static_cast<long double>(w);
+        const long double v = (k < 0 ? w_l / scale : w_l * scale);
+
+        const auto r = static_cast<double>(v);
+
+        if (!std::isnormal(r)) {
+            return false;
+        }
+        // A nonzero tail adds less than 10^-18 relative, as w then has all 19 digits
+        const long double bound = v * (static_cast<long double>(roundings) * limits::epsilon() + (inexact ? 1e-18L : 0));
+
+        // The midpoints to the neighbouring doubles are exact in long double
+        const long double below = (static_cast<long double>(r) + std::nextafter(r, 0.0)) / 2;
+        const long double above = (static_cast<long double>(r) + std::nextafter(r, HUGE_VAL)) / 2;
+
+        if (v - below <= bound || above - v <= bound) {
+            return false;
+        }
+        result = r;
+        return true;
+    }
+
+    // |m| * 10^e for the decimal digits of m, least significant first, rounded exactly
+    double to_double_exact(const BigInteger::digit_string &digits, int64_t e)
+    {
+        const std::size_t take = std::min(digits.size(), EXACT_DIGITS);
+
+        bool sticky = digits.size() > take;
+
+        std::string top;
+
+        for (std::size_t i = digits.size(); i-- > digits.size() - take;) {
+            top.push_back(static_cast<char>('0' + digits[i]));
+        }
+        const int64_t f = e + static_cast<int64_t>(digits.size() - take);
+        const int64_t adj = f + static_cast<int64_t>(take) - 1;
+
+        // q = floor(t * 10^f * 2^-b) lies in [2^57, 2^62)
+        const auto b = static_cast<int64_t>(std::floor(static_cast<double>(adj + 1) * std::log2(10.0))) - 62;
+
+        BigInteger num(top);
+        BigInteger den = BigConstants::ONE;
+
+        if (f >= 0)
+            num *= BigConstants::TEN ^ BigInteger(f);
+        else
+            den = BigConstants::TEN ^ BigInteger(-f);
+
+        if (b >= 0)
+            den <<= static_cast<std::size_t>(b);
+        else
+            num <<= static_cast<std::size_t>(-b);
+
+        BigInteger q;
+        BigInteger r;
+
+        BigInteger::divmod(num, den, q, r);
+
+        sticky = sticky || !Null(r);
+
+        return round_to_double(static_cast<uint64_t>(static_cast<int64_t>(q)), b, sticky);
+    }
+
+    // The cast of BigInteger to int64_t yields the magnitude
+    int64_t signed_value(const BigInteger &n) {
+        const auto magnitude = static_cast<int64_t>(n);
+        return (n < BigConstants::ZERO ? -magnitude : magnitude);
+    }
+
+    void check_precision(std::size_t digits)
+    {
+        if (!digits) {
+            throw std::invalid_argument("Arithmetic Error: BigDecimal precision must be at least one digit.");
+        }
+    }
+
+    // Splits "[+-]digits[.digits][e[+-]digits]" into an integer mantissa and a decimal exponent
+    void parse(const std::string &s, BigInteger &mantissa, int64_t &exponent)
+    {
+        std::size_t i = 0;
+        bool negative = false;
+
+        if (i < s.size() && (s[i] == '+' || s[i] == '-')) {
+            negative = (s[i++] == '-');
+        }
+        std::string digits;
+        bool point = false;
+        int64_t scale = 0;
+
+        for (; i < s.size(); ++i)
+        {
+            if (isdigit(static_cast<unsigned char>(s[i])))
+            {
+                digits += s[i];
+                scale -= point;
+            }
+            else if (s[i] == '.' && !point)
+                point = true;
+            else
+                break;
+        }
+        bool valid = !digits.empty();
+        int64_t e = 0;
+
+        if (valid && i < s.size() && (s[i] == 'e' || s[i] == 'E'))
+        {
+            bool e_negative = false;
+
+            if (++i < s.size() && (s[i] == '+' || s[i] == '-')) {
+                e_negative = (s[i++] == '-');
+            }
+            const std::size_t start = i;
+
+            for (; i < s.size() && isdigit(static_cast<unsigned char>(s[i])) && valid; ++i)
+            {
+                valid = e < INT64_MAX / 100;
+                e = e * 10 + (s[i] - '0');
+            }
+            valid = valid && i > start;
+            e = e_negative ? -e : e;
+        }
+        if (!valid || i != s.size())
+        {
+            std::string err_message;
+
+            err_message = "Input Error: Could not parse \"";
+            err_message += s;
+            err_message += "\" to decimal value.";
+
+            throw std::invalid_argument(err_message);
+        }
+        const std::size_t lead = digits.find_first_not_of('0');
+
+        digits = (lead == std::string::npos ? "0" : digits.substr(lead));
+
+        if (negative && digits != "0") {
+            digits.insert(digits.begin(), '-');
+        }
+        mantissa = BigInteger(digits);
+        exponent = e + scale;
+    }
+}
+
+
+/* * * * * * * * * * * Constructors * * * * * * * * * * */
 
 BigDecimal::BigDecimal(double d)
 {
+    if (!std::isfinite(d)) {
+        throw std::invalid_argument("Input Error: BigDecimal cannot represent NaN or infinity.");
+    }
+    if (d == 0) {
+        return;
+    }
+    // d = m * 2^e exactly, with m odd
+    int e;
+    auto m = static_cast<int64_t>(std::ldexp(std::frexp(std::fabs(d), &e), DOUBLE_BITS));
+
+    e -= DOUBLE_BITS;
+
+    const int zeros = std::countr_zero(static_cast<uint64_t>(m));
+
+    m >>= zeros;
+    e += zeros;
+
+    // m * 2^-k = m * 5^k * 10^-k
+    if (e >= 0)
+        mantissa = BigInteger(m) << static_cast<std::size_t>(e);
+    else
+    {
+        mantissa = BigInteger(m) * power_of_five(-e);
+        exponent = e;
+    }
+    if (d < 0) {
+        mantissa = BigConstants::ZERO - mantissa;
+    }
+}
+
+BigDecimal::BigDecimal(std::string &s)
+{
+    parse(s, mantissa, exponent);
+    normalise();
+}
+
+BigDecimal::BigDecimal(const char *s)
+{
+    parse(s, mantissa, exponent);
+    normalise();
+}
+
+BigDecimal::BigDecimal(const BigInteger &n) : mantissa(n) {
+    normalise();
+}
+
+BigDecimal::BigDecimal(const BigInteger &m, int64_t e) : mantissa(m), exponent(e) {
+    normalise();
+}
+
+/* * * * * * * * * * * Working precision * * * * * * * * * * */
+
+DecimalContext::DecimalContext(std::size_t precision, BigDecimal::Rounding rounding, std::size_t guard)
+        : precision(precision), rounding(rounding), guard(guard)
+{
+    check_precision(precision);
+}
+
+DecimalContext DecimalContext::from_bits(std::size_t bits, BigDecimal::Rounding rounding, std::size_t guard)
+{
+    // ceil(bits * log10(2)), exact for any realistic bit count
+    const auto digits = static_cast<std::size_t>(std::ceil(static_cast<double>(bits) / LOG2_10));
+
+    return DecimalContext(std::max<std::size_t>(digits, 1), rounding, guard);
+}
+
+std::size_t DecimalContext::bits() const {
+    return static_cast<std::size_t>(static_cast<double>(precision) * LOG2_10);
+}
+
+const DecimalContext &DecimalContext::current() {
+    return context;
+}
+
+DecimalScope::DecimalScope(const DecimalContext &ctx) : previous(context) {
+    context = ctx;
+}
+
+DecimalScope::~DecimalScope() {
+    context = previous;
+}
+
+void BigDecimal::set_precision(std::size_t digits)
+{
+    check_precision(digits);
+    context.precision = digits;
+}
+
+std::size_t BigDecimal::precision() {
+    return context.precision;
+}
+
+void BigDecimal::set_rounding(Rounding mode) {
+    context.rounding = mode;
+}
+
+BigDecimal::Rounding BigDecimal::rounding() {
+    return context.rounding;
+}
+
+/* * * * * * * * * * * Representation * * * * * * * * * * */
+
+void BigDecimal::shift_up(BigInteger &m, std::size_t k)
+{
+    if (k && !Null(m)) {
+        m.digits.insert(static_cast<std::size_t>(0), k, static_cast<char>(0));
+    }
+}
+
+void BigDecimal::normalise()
+{
+    BigInteger::digit_string &d = mantissa.digits;
+
+    std::size_t zeros = 0;
+
+    while (zeros < d.size() && d[zeros] == 0) {
+        ++zeros;
+    }
+    if (zeros == d.size())
+    {
+        mantissa = BigConstants::ZERO;
+        exponent = 0;
+        return;
+    }
+    d.erase(0, zeros);
+    exponent += static_cast<int64_t>(zeros);
+}
+
+void BigDecimal::round_in_place(std::size_t digits, Rounding mode)
+{
+    check_precision(digits);
+
+    BigInteger::digit_string &d = mantissa.digits;
+
+    if (d.size() > digits)
+    {
+        const std::size_t k = d.size() - digits;
+
+        const int first = d[k - 1];
+        const bool sticky = std::any_of(d.begin(), d.begin() + static_cast<std::ptrdiff_t>(k - 1),
+                                        [](char c) { return c != 0; });
+        const bool odd = d[k] & 1;
+
+        d.erase(0, k);
+        exponent += static_cast<int64_t>(k);
+
+        if (round_up(mode, first, sticky, odd, mantissa.sign == NEGATIVE))
+        {
+            std::size_t i = 0;
+
+            while (i < d.size() && d[i] == 9) {
+                d[i++] = 0;
+            }
+            if (i == d.size())
+                d.push_back(1);
+            else
+                ++d[i];
+        }
+    }
+    normalise();
+}
+
+std::string BigDecimal::toString() const
+{
+    std::string digits = mantissa.toString();
+
+    const bool negative = is_negative();
+
+    if (negative) {
+        digits.erase(0, 1);
+    }
+    const int64_t adj = adjusted();
+
+    std::string str = (negative ? "-" : "");
+
+    // Plain notation for moderate magnitudes and scientific notation otherwise, as JavaScript prints doubles
+    if (exponent >= 0 && adj < 21)
+    {
+        str += digits;
+        str.append(static_cast<std::size_t>(exponent), '0');
+    }
+    else if (exponent < 0 && adj >= -7)
+    {
+        if (adj >= 0)
+        {
+            str += digits.substr(0, static_cast<std::size_t>(adj + 1));
+            str += '.';
+            str += digits.substr(static_cast<std::size_t>(adj + 1));
+        }
+        else
+        {
+            str += "0.";
+            str.append(static_cast<std::size_t>(-adj - 1), '0');
+            str += digits;
+        }
+    }
+    else
+    {
+        str += digits[0];
+
+        if (digits.size() > 1)
+        {
+            str += '.';
+            str += digits.substr(1);
+        }
+        str += (adj < 0 ? "e-" : "e+");
+        str += std::to_string(adj < 0 ? -adj : adj);
+    }
+    return str;
+}
+
+bool Null(const BigDecimal &a) {
+    return Null(a.mantissa);
+}
+
+int64_t BigDecimal::adjusted() const {
+    return exponent + static_cast<int64_t>(length(mantissa)) - 1;
+}
+
+bool BigDecimal::is_negative() const {
+    return mantissa.sign == NEGATIVE && !Null(mantissa);
+}
+
+/* * * * * * * * * * * Operator Overloading * * * * * * * * * * */
+
+// -------- Direct assignment --------
+BigDecimal &BigDecimal::operator = (const BigInteger &n)
+{
+    mantissa = n;
+    exponent = 0;
+
+    normalise();
+    return *this;
+}
+
+BigDecimal &BigDecimal::operator = (BigInteger &&n) noexcept
+{
+    mantissa = std::move(n);
+    exponent = 0;
+
+    normalise();
+    return *this;
+}
+
+// -------- Casts --------
+BigDecimal::operator double() const
+{
+    if (Null(*this)) {
+        return 0;
+    }
+    const bool negative = is_negative();
+    const int64_t adj = adjusted();
+
+    // Beyond DBL_MAX, or below half the least subnormal
+    if (adj > DBL_MAX_10_EXP) {
+        return (negative ? -HUGE_VAL : HUGE_VAL);
+    }
+    if (adj < DBL_MIN_10_EXP - DBL_DIG - 3) {
+        return (negative ? -0.0 : 0.0);
+    }
+    const BigInteger::digit_string &digits = mantissa.digits;
+
+    // The leading TOP_LIMB_DIGITS digits w, with x = (w + tail) * 10^k; the mantissa has no trailing zeros, so
+    // the tail is nonzero exactly when digits were left out
+    const std::size_t take = std::min(digits.size(), TOP_LIMB_DIGITS);
+    const bool inexact = digits.size() > take;
+
+    uint64_t w = 0;
+
+    for (std::size_t i = digits.size(); i-- > digits.size() - take;) {
+        w = w * 10 + static_cast<uint64_t>(digits[i]);
+    }
+    const int64_t k = exponent + static_cast<int64_t>(digits.size() - take);
+
+    double result;
+
+    if (!inexact && w <= (uint64_t(1) << DOUBLE_BITS) && k >= -EXACT_POW10 && k <= EXACT_POW10)
+    {
+        // w and 10^|k| are exact doubles, so one correctly rounded operation gives the result
+        const double w_d = static_cast<double>(w);
+        const double p = power_of_ten(k < 0 ? -k : k);
+
+        result = (k < 0 ? w_d / p : w_d * p);
+    }
+    else if (!decided_by_top_limb(w, k, inexact, result))
+        result = to_double_exact(digits, exponent);
+
+    return (negative ? -result : result);
+}
+
+BigDecimal::operator BigInteger() const
+{
+    if (exponent >= 0)
+    {
+        BigInteger n = mantissa;
+
+        shift_up(n, static_cast<std::size_t>(exponent));
+        return n;
+    }
+    if (static_cast<uint64_t>(-exponent) >= length(mantissa)) {
+        return BigConstants::ZERO;
+    }
+    BigInteger n = mantissa;
+
+    n.digits.erase(0, static_cast<std::size_t>(-exponent));
+    return n;
+}
+
+// -------- Addition and Subtraction --------
+BigDecimal &operator += (BigDecimal &a, const BigDecimal &b)
+{
+    a = BigDecimal::add(a, b, context.precision, context.rounding);
+    return a;
+}
+
+BigDecimal &operator -= (BigDecimal &a, const BigDecimal &b)
+{
+    a = BigDecimal::sub(a, b, context.precision, context.rounding);
+    return a;
+}
+
+BigDecimal operator + (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::add(a, b, context.precision, context.rounding);
+}
+
+BigDecimal operator - (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::sub(a, b, context.precision, context.rounding);
+}
+
+BigDecimal operator - (const BigDecimal &a)
+{
+    BigDecimal temp(a);
+
+    temp.mantissa = BigConstants::ZERO - a.mantissa;
+    return temp;
+}
+
+// -------- Comparison operators --------
+bool operator == (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) == 0;
+}
+
+bool operator != (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) != 0;
+}
+
+bool operator > (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) > 0;
+}
+
+bool operator < (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) < 0;
+}
+
+bool operator >= (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) >= 0;
+}
+
+bool operator <= (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) <= 0;
+}
+
+// -------- Multiplication and Division --------
+BigDecimal &operator *= (BigDecimal &a, const BigDecimal &b)
+{
+    a = BigDecimal::mul(a, b, context.precision, context.rounding);
+    return a;
+}
+
+BigDecimal &operator /= (BigDecimal &a, const BigDecimal &b)
+{
+    a = BigDecimal::div(a, b, context.precision, context.rounding);
+    return a;
+}
+
+BigDecimal operator * (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::mul(a, b, context.precision, context.rounding);
+}
+
+BigDecimal operator / (const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::div(a, b, context.precision, context.rounding);
+}
+
+// -------- Power Function --------
+BigDecimal &operator ^= (BigDecimal &a, const BigDecimal &b)
+{
+    a = a ^ b;
+    return a;
+}
+
+BigDecimal operator ^ (const BigDecimal &a, const BigDecimal &b)
+{
+    if (!b.is_integer()) {
+        throw std::invalid_argument("Arithmetic Error: BigDecimal powers need an integral exponent.");
+    }
+    if (b.adjusted() >= 18) {
+        throw std::invalid_argument("Arithmetic Error: BigDecimal exponent out of range.");
+    }
+    return BigDecimal::pow(a, signed_value(static_cast<BigInteger>(b)), context.precision, context.rounding);
+}
+
+// -------- Read and Write --------
+std::ostream &operator << (std::ostream &os, const BigDecimal &a) {
+    return os << a.toString();
+}
+
+std::istream &operator >> (std::istream &is, BigDecimal &a)
+{
+    std::string s;
+
+    if (is >> s) {
+        a = BigDecimal(s);
+    }
+    return is;
+}
+
+/* * * * * * * * * * * Arithmetic functions * * * * * * * * * * */
+
+int BigDecimal::compare(const BigDecimal &a, const BigDecimal &b)
+{
+    const int sa = Null(a) ? 0 : a.is_negative() ? -1 : 1;
+    const int sb = Null(b) ? 0 : b.is_negative() ? -1 : 1;
+
+    if (sa != sb) {
+        return sa < sb ? -1 : 1;
+    }
+    if (!sa) {
+        return 0;
+    }
+    int magnitude = 0;
+
+    if (a.adjusted() != b.adjusted())
+        magnitude = a.adjusted() < b.adjusted() ? -1 : 1;
+    else
+    {
+        // Equal leading positions: compare from the top; without trailing zeros the longer one is larger
+        const BigInteger::digit_string &x = a.mantissa.digits;
+        const BigInteger::digit_string &y = b.mantissa.digits;
+
+        std::size_t i = x.size();
+        std::size_t j = y.size();
+
+        while (i && j && !magnitude)
+        {
+            --i;
+            --j;
+
+            if (x[i] != y[j]) {
+                magnitude = x[i] < y[j] ? -1 : 1;
+            }
+        }
+        if (!magnitude && (i || j)) {
+            magnitude = i ? 1 : -1;
+        }
+    }
+    return sa * magnitude;
+}
+
+BigDecimal BigDecimal::round(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    BigDecimal result(x);
+
+    result.round_in_place(digits, mode);
+    return result;
+}
+
+BigDecimal BigDecimal::add(const BigDecimal &a, const BigDecimal &b, std::size_t digits, Rounding mode)
+{
+    if (Null(a)) {
+        return round(b, digits, mode);
+    }
+    if (Null(b)) {
+        return round(a, digits, mode);
+    }
+    // An operand lying wholly below position `low`, and below every digit of the other operand, only
+    // decides the rounding through its sign: the other operand and the rounding boundaries both lie on
+    // multiples of that last digit. It is replaced by a single unit below them instead of being aligned
+    // digit by digit.
+    const int64_t low = std::max(a.adjusted(), b.adjusted()) - static_cast<int64_t>(digits) - 2;
+
+    const int64_t below_b = std::min(low, b.exponent);
+    const int64_t below_a = std::min(low, a.exponent);
+
+    const BigDecimal x = (a.adjusted() < below_b ? BigDecimal(a.is_negative() ? -1 : 1, below_b - 1) : a);
+    const BigDecimal y = (b.adjusted() < below_a ? BigDecimal(b.is_negative() ? -1 : 1, below_a - 1) : b);
+
+    const int64_t e = std::min(x.exponent, y.exponent);
+
+    BigInteger m = x.mantissa;
+    BigInteger n = y.mantissa;
+
+    shift_up(m, static_cast<std::size_t>(x.exponent - e));
+    shift_up(n, static_cast<std::size_t>(y.exponent - e));
+
+    BigDecimal result;
+
+    result.mantissa = (m += n);
+    result.exponent = e;
+
+    result.round_in_place(digits, mode);
+    return result;
+}
+
+BigDecimal BigDecimal::sub(const BigDecimal &a, const BigDecimal &b, std::size_t digits, Rounding mode) {
+    return add(a, -b, digits, mode);
+}
+
+BigDecimal BigDecimal::mul(const BigDecimal &a, const BigDecimal &b, std::size_t digits, Rounding mode)
+{
+    BigDecimal result;
+
+    result.mantissa = a.mantissa * b.mantissa;
+    result.exponent = a.exponent + b.exponent;
+
+    result.round_in_place(digits, mode);
+    return result;
+}
+
+BigDecimal BigDecimal::div(const BigDecimal &a, const BigDecimal &b, std::size_t digits, Rounding mode)
+{
+    if (Null(b)) {
+        throw std::invalid_argument("Arithmetic Error: Division By 0");
+    }
+    if (Null(a)) {
+        return {};
+    }
+    check_precision(digits);
+
+    if (digits >= DIV_NEWTON_DIGITS)
+    {
+        const BigDecimal divisor = abs(b);
+        const std::size_t work = digits + NEWTON_GUARD;
+
+        const BigDecimal q = mul(round(abs(a), work + 1), inverse_root(divisor, 1, work), work + 1);
+
+        // |a / b - q| < 3 * 10^-work relative
+        return round_near(q, a.is_negative() != b.is_negative(), q.adjusted() + 2 - static_cast<int64_t>(work),
+                          digits, mode, [&](const BigDecimal &B) {
+                              return compare(abs(a), BigDecimal(B.mantissa * divisor.mantissa,
+                                                                B.exponent + divisor.exponent));
+                          });
+    }
+    const auto la = static_cast<int64_t>(length(a.mantissa));
+    const auto lb = static_cast<int64_t>(length(b.mantissa));
+
+    // Scale the dividend so that the quotient has at least digits + 1 digits; a nonzero remainder
+    // then becomes one more, sticky, digit below them.
+    const auto s = static_cast<std::size_t>(std::max<int64_t>(0, static_cast<int64_t>(digits) + 1 + lb - la));
+
+    BigInteger n = a.mantissa;
+    BigInteger d = b.mantissa;
+
+    n.sign = POSITIVE;
+    d.sign = POSITIVE;
+
+    shift_up(n, s);
+
+    BigDecimal result;
+    BigInteger r;
+
+    BigInteger::divmod(n, d, result.mantissa, r);
+
+    shift_up(result.mantissa, 1);
+
+    if (!Null(r)) {
+        result.mantissa.digits[0] = 1;
+    }
+    result.mantissa.sign = (a.is_negative() != b.is_negative() ? NEGATIVE : POSITIVE);
+    result.exponent = a.exponent - b.exponent - static_cast<int64_t>(s) - 1;
+
+    result.round_in_place(digits, mode);
+    return result;
+}
+
+BigDecimal BigDecimal::pow(const BigDecimal &x, int64_t n, std::size_t digits, Rounding mode)
+{
+    check_precision(digits);
+
+    if (n == 0) {
+        return BigDecimal(BigConstants::ONE);
+    }
+    if (Null(x))
+    {
+        if (n < 0) {
+            throw std::invalid_argument("Arithmetic Error: Division By 0");
+        }
+        return {};
+    }
+    uint64_t e = (n < 0 ? 0 - static_cast<uint64_t>(n) : static_cast<uint64_t>(n));
+
+    // Each of the at most 2 log2(e) roundings costs half a unit of the working precision
+    const std::size_t work = digits + std::to_string(e).size() + std::max<std::size_t>(context.guard, 2);
+
+    BigDecimal result(BigConstants::ONE);
+    BigDecimal base(x);
+
+    while (true)
+    {
+        if (e & 1) {
+            result = mul(result, base, work);
+        }
+        if (!(e >>= 1)) {
+            break;
+        }
+        base = mul(base, base, work);
+    }
+    if (n < 0) {
+        result = div(BigDecimal(BigConstants::ONE), result, work);
+    }
+    return round(result, digits, mode);
+}
+
+BigDecimal BigDecimal::abs(const BigDecimal &x) {
+    return x.is_negative() ? -x : x;
+}
+
+BigDecimal BigDecimal::scale(const BigDecimal &x, int64_t k)
+{
+    BigDecimal result(x);
+
+    if (!Null(result)) {
+        result.exponent += k;
+    }
+    return result;
+}
+
+BigDecimal BigDecimal::round_near(const BigDecimal &approx, bool negative, int64_t err_exp, std::size_t digits,
+                                  Rounding mode, const std::function<int(const BigDecimal &)> &side)
+{
+    check_precision(digits);
+
+    // The boundaries between results of `digits` digits are the multiples of 5 * 10^unit; a power of ten,
+    // where the result gains a digit, is one of them too.
+    const int64_t unit = approx.adjusted() - static_cast<int64_t>(digits);
+
+    // Wide enough for every sum and difference below to be exact
+    const std::size_t exact = std::max(length(approx.mantissa), digits) + 8;
+
+    const auto units = static_cast<BigInteger>(scale(approx, -unit));
+
+    const BigDecimal low(units - units.mod_5(), unit);
+    const BigDecimal high = add(low, BigDecimal(5, unit), exact);
+
+    const BigDecimal error(1, err_exp);
+
+    const BigDecimal *boundary = nullptr;
+
+    if (sub(approx, low, exact) < error)
+        boundary = &low;
+    else if (sub(high, approx, exact) < error)
+        boundary = &high;
+
+    BigDecimal result;
+
+    if (!boundary)
+        result = approx;
+    else
+    {
+        // v lies on the boundary or strictly between it and the next boundary over
+        const int s = side(*boundary);
+
+        result = (s ? add(*boundary, BigDecimal(s, unit - 3), exact) : *boundary);
+    }
+    if (negative) {
+        result = -result;
+    }
+    result.round_in_place(digits, mode);
+    return result;
+}
+
+BigDecimal BigDecimal::inverse_root(const BigDecimal &x, int64_t n, std::size_t digits)
+{
+    // Newton's iteration multiplies the squared error by (n + 1) / 2
+    const std::size_t g = std::to_string(n).size();
+
+    std::vector<std::size_t> steps;
+
+    for (std::size_t d = digits + g + 2; ; d = d / 2 + 2)
+    {
+        steps.push_back(d);
+
+        if (d <= SEED_DIGITS) break;
+    }
+    // Seed: x = f * 10^adj with 1 <= f < 10 and adj = q n + r, so x^(-1/n) = 10^(-(log10 f + r) / n) * 10^-q
+    const int64_t adj = x.adjusted();
+
+    int64_t q = adj / n;
+    int64_t r = adj % n;
+
+    if (r < 0)
+    {
+        r += n;
+        --q;
+    }
+    const auto f = static_cast<double>(scale(round(x, 17), -adj));
+
+    BigDecimal y = scale(BigDecimal(std::pow(10.0, -(std::log10(f) + static_cast<double>(r)) / static_cast<double>(n))), -q);
+
+    const BigDecimal one(BigConstants::ONE);
+    const BigDecimal inv_n = (n == 1 ? one : div(one, BigDecimal(BigInteger(n)), steps.front() + 2));
+
+    for (std::size_t i = steps.size(); i-- > 0;)
+    {
+        const std::size_t d = steps[i] + g;
+
+        const BigDecimal e = sub(one, mul(round(x, d + 2), pow(y, n, d + 2), d + 2), d + 2);
+
+        // e is about 10^(-d / 2), so the correction needs only half the digits
+        y = add(y, mul(mul(y, e, d / 2 + 3), inv_n, d / 2 + 3), d + 2);
+    }
+    return round(y, digits + 2);
+}
+
+BigDecimal BigDecimal::reciprocal(const BigDecimal &x, std::size_t digits)
+{
+    if (Null(x)) {
+        throw std::invalid_argument("Arithmetic Error: Division By 0");
+    }
+    check_precision(digits);
+
+    const BigDecimal y = inverse_root(abs(x), 1, digits + 2);
+
+    return round(x.is_negative() ? -y : y, digits);
+}
+
+BigDecimal BigDecimal::sqrt(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    if (x.is_negative()) {
+        throw std::invalid_argument("Arithmetic Error: sqrt(x) not defined for x < 0.");
+    }
+    check_precision(digits);
+
+    if (Null(x)) {
+        return {};
+    }
+    const std::size_t work = digits + NEWTON_GUARD;
+
+    // sqrt(x) = x / sqrt(x)
+    const BigDecimal s = mul(round(x, work + 1), inverse_root(x, 2, work), work + 1);
+
+    return round_near(s, false, s.adjusted() + 2 - static_cast<int64_t>(work), digits, mode,
+                      [&](const BigDecimal &B) {
+                          return compare(x, BigDecimal(B.mantissa * B.mantissa, 2 * B.exponent));
+                      });
+}
+
+BigDecimal BigDecimal::sqrt_n(int n, const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    if (n < 1) {
+        throw std::invalid_argument("Arithmetic Error: sqrt_n(n, x) requires n >= 1.");
+    }
+    if (x.is_negative() && n % 2 == 0) {
+        throw std::invalid_argument("Arithmetic Error: sqrt_n(n, x) not defined for x < 0 and even n.");
+    }
+    check_precision(digits);
+
+    if (n == 1 || Null(x)) {
+        return round(x, digits, mode);
+    }
+    if (n == 2) {
+        return sqrt(x, digits, mode);
+    }
+    const BigDecimal a = abs(x);
+
+    const std::size_t work = digits + NEWTON_GUARD;
+    const std::size_t g = std::to_string(n).size();
+
+    // x^(1/n) = x * (x^(-1/n))^(n-1); the power multiplies the relative error by n - 1
+    const BigDecimal y = inverse_root(a, n, work + g);
+    const BigDecimal s = mul(round(a, work + 1), pow(y, n - 1, work + g), work + 1);
+
+    return round_near(s, x.is_negative(), s.adjusted() + 2 - static_cast<int64_t>(work), digits, mode,
+                      [&](const BigDecimal &B) {
+                          return compare(a, BigDecimal(B.mantissa ^ BigInteger(n), n * B.exponent));
+                      });
+}
+
+BigDecimal BigDecimal::sqrt(const BigDecimal &x) {
+    return sqrt(x, context.precision, context.rounding);
+}
 
-}
\ No newline at end of file
+BigDecimal BigDecimal::sqrt_n(int n, const BigDecimal &x) {
+    return sqrt_n(n, x, context.precision, context.rounding);
+}
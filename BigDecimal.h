@@ -4,51 +4,123 @@
 #include "BigInteger.h"
 
 #include <fstream>
+#include <functional>
+
+
+/*
+ * Arbitrary precision floating point number mantissa * 10^exponent.
+ *
+ * Results of the arithmetic operators are rounded to the calling thread's DecimalContext, whose precision
+ * counts significant decimal digits, so that mantissas stay bounded through long computations. The static
+ * add, sub, mul and div functions take the precision and rounding explicitly.
+ *
+ * Long divisions and roots run Newton's iteration on x^(-1/n), doubling the precision at each step, so
+ * they cost a small multiple of one full-precision multiplication.
+ */
+class BigDecimal {
+public:
+    enum class Rounding { HALF_EVEN, HALF_UP, HALF_DOWN, DOWN, UP, FLOOR, CEILING };
 
+    static constexpr std::size_t DEFAULT_PRECISION = 50;
 
-class BigDecimal {
-private:
-    BigInteger exponent;
+    // Extra digits carried by the intermediate steps of multi-step functions
+    static constexpr std::size_t DEFAULT_GUARD = 5;
 
+private:
+    // Kept without trailing zeros; zero is 0 * 10^0
     BigInteger mantissa;
 
+    int64_t exponent = 0;
+
+    // Rounds to `digits` significant digits and strips trailing zeros
+    void round_in_place(std::size_t digits, Rounding mode);
+
+    void normalise();
+
+    // m * 10^k
+    static void shift_up(BigInteger &m, std::size_t k);
+
+    // Correctly rounds v > 0 (negated if `negative`) from an approximation with |v - approx| < 10^err_exp.
+    // Only when a rounding boundary B lies within the error is side(B), the sign of v - B, consulted.
+    static BigDecimal round_near(const BigDecimal &approx, bool negative, int64_t err_exp, std::size_t digits,
+                                 Rounding mode, const std::function<int(const BigDecimal &)> &side);
+
+    // x^(-1/n) for x > 0 with a relative error below 10^-digits, by Newton's iteration
+    // y += y (1 - x y^n) / n at precisions doubling from a double precision seed
+    static BigDecimal inverse_root(const BigDecimal &x, int64_t n, std::size_t digits);
+
 public:
     // Constructors
     BigDecimal() = default;
 
+    // Exactly the binary value of a finite double, e.g. 0.1000000000000000055511151231257827021181583404541015625
     BigDecimal(double);
 
     BigDecimal(std::string &s);
 
     BigDecimal(const char *s);
 
-    BigDecimal(const BigDecimal &);
+    BigDecimal(const BigDecimal &) = default;
 
-    BigDecimal(BigDecimal&&);
+    BigDecimal(BigDecimal&&) noexcept = default;
 
     BigDecimal(const BigInteger &);
 
+    // mantissa * 10^exponent, exactly
+    BigDecimal(const BigInteger &mantissa, int64_t exponent);
+
     ~BigDecimal() = default;
 
 
+    // Precision and rounding of the calling thread's current DecimalContext
+    static void set_precision(std::size_t digits);
+    static std::size_t precision();
+
+    static void set_rounding(Rounding mode);
+    static Rounding rounding();
+
+
     // Decimal String representation:
     std::string toString() const;
 
     friend bool Null(const BigDecimal &);
 
+    const BigInteger &get_mantissa() const { return mantissa; }
+
+    int64_t get_exponent() const { return exponent; }
+
+    // Position of the leading digit: 10^adjusted <= |x| < 10^(adjusted + 1) for x != 0
+    int64_t adjusted() const;
+
+    bool is_negative() const;
+
+    bool is_integer() const { return exponent >= 0; }
+
 
     /* * * * Operator Overloading * * * */
 
     // Direct assignment
+    BigDecimal &operator = (const BigDecimal &) = default;
+    BigDecimal &operator = (BigDecimal &&) noexcept = default;
+
     BigDecimal &operator = (const BigInteger &);
     BigDecimal &operator = (BigInteger &&) noexcept;
 
-    // Cast to double
+    // Cast to double, rounded to nearest with ties to even; overflows to infinity and underflows to zero
     explicit operator double() const;
 
-    // Cast to Integer
+    // Cast to Integer, truncating toward zero
     explicit operator BigInteger() const;
 
+    // Addition and Subtraction
+    friend BigDecimal &operator += (BigDecimal &, const BigDecimal &);
+    friend BigDecimal &operator -= (BigDecimal &, const BigDecimal &);
+
+    friend BigDecimal operator + (const BigDecimal &, const BigDecimal &);
+    friend BigDecimal operator - (const BigDecimal &, const BigDecimal &);
+
+    friend BigDecimal operator - (const BigDecimal &);
+
     // Comparison operators
     friend bool operator == (const BigDecimal &, const BigDecimal &);
     friend bool operator != (const BigDecimal &, const BigDecimal &);
@@ -66,7 +138,7 @@ public:
     friend BigDecimal operator * (const BigDecimal &, const BigDecimal &);
     friend BigDecimal operator / (const BigDecimal &, const BigDecimal&);
 
-    // Power Function
+    // Power Function, for integral exponents
     friend BigDecimal &operator ^= (BigDecimal &, const BigDecimal &);
     friend BigDecimal operator ^ (const BigDecimal &, const BigDecimal &);
 
@@ -77,13 +149,67 @@ public:
 
     /* * * * Arithmetic functions * * * */
 
+    // -1, 0 or 1 as a <, = or > b
+    static int compare(const BigDecimal &a, const BigDecimal &b);
+
+    // Correctly rounded operations at an explicit precision
+    static BigDecimal round(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+
+    static BigDecimal add(const BigDecimal &, const BigDecimal &, std::size_t digits,
+                          Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal sub(const BigDecimal &, const BigDecimal &, std::size_t digits,
+                          Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal mul(const BigDecimal &, const BigDecimal &, std::size_t digits,
+                          Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal div(const BigDecimal &, const BigDecimal &, std::size_t digits,
+                          Rounding mode = Rounding::HALF_EVEN);
+
+    // x^n with an error below one unit in the last place, working with the context's guard digits
+    static BigDecimal pow(const BigDecimal &x, int64_t n, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+
+    // x * 10^k, exactly
+    static BigDecimal scale(const BigDecimal &x, int64_t k);
+
+    // 1 / x with an error below one unit in the last place
+    static BigDecimal reciprocal(const BigDecimal &x, std::size_t digits);
+
+    // Correctly rounded roots; sqrt_n(n, x) is the real n-th root, defined for x < 0 when n is odd
+    static BigDecimal sqrt(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal sqrt_n(int, const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+
     // Basic functions
+    static BigDecimal abs(const BigDecimal &);
     static BigDecimal sqrt(const BigDecimal &);
     static BigDecimal sqrt_n(int, const BigDecimal &);
+    static BigDecimal ln(const BigDecimal &);
+    static BigDecimal exp(const BigDecimal &);
     static BigDecimal log2(const BigDecimal &);
     static BigDecimal log10(const BigDecimal &);
 
-    // Trigonometric functions
+    // Correctly rounded logarithms and exponential. ln runs the arithmetic-geometric mean, ln x ~ pi / (2 AGM(1, 4 / s))
+    // for s = x 2^m large; exp reduces by multiples of ln 10 and sums the Taylor series by the bit-burst method.
+    static BigDecimal ln(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal exp(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal log2(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal log10(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+
+    // Correctly rounded trigonometric functions, in radians. sin and cos reduce the argument by multiples of
+    // pi / 2 and sum Taylor series by binary splitting over chunks of the argument (Brent's bit-burst method);
+    // the inverse functions run Newton's iteration on them. acot x = atan(1 / x).
+    static BigDecimal sin(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal cos(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal tan(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal cot(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+
+    static BigDecimal asin(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal acos(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal atan(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal acot(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+
+    static BigDecimal asec(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+    static BigDecimal acsc(const BigDecimal &, std::size_t digits, Rounding mode = Rounding::HALF_EVEN);
+
+    // Trigonometric functions at the context's precision
     static BigDecimal sin(const BigDecimal &);
     static BigDecimal cos(const BigDecimal &);
     static BigDecimal tan(const BigDecimal &);
@@ -98,10 +224,81 @@ public:
     static BigDecimal acsc(const BigDecimal &);
 };
 
+
+/*
+ * Working precision, rounding mode and guard digits of BigDecimal arithmetic.
+ *
+ * Each thread has its own current context, consulted by every BigDecimal operator; threads may therefore
+ * work at different precisions without locking. A DecimalScope installs a context for the lifetime of a
+ * block and restores the previous one when it ends.
+ */
+class DecimalContext
+{
+public:
+    // Significant decimal digits of every result
+    std::size_t precision;
+
+    BigDecimal::Rounding rounding;
+
+    std::size_t guard;
+
+    explicit DecimalContext(std::size_t precision = BigDecimal::DEFAULT_PRECISION,
+                            BigDecimal::Rounding rounding = BigDecimal::Rounding::HALF_EVEN,
+                            std::size_t guard = BigDecimal::DEFAULT_GUARD);
+
+    // The fewest digits that hold `bits` significant bits
+    static DecimalContext from_bits(std::size_t bits,
+                                    BigDecimal::Rounding rounding = BigDecimal::Rounding::HALF_EVEN,
+                                    std::size_t guard = BigDecimal::DEFAULT_GUARD);
+
+    // Significant bits held by the precision
+    std::size_t bits() const;
+
+    // The calling thread's context
+    static const DecimalContext &current();
+};
+
+// Installs a context as the calling thread's current one until the end of the enclosing block
+class DecimalScope
+{
+private:
+    DecimalContext previous;
+
+public:
+    explicit DecimalScope(const DecimalContext &);
+
+    DecimalScope(const DecimalScope &) = delete;
+    DecimalScope &operator = (const DecimalScope &) = delete;
+
+    ~DecimalScope();
+};
+
 namespace BigConstants
 {
-    BigDecimal& PI();
-    BigDecimal& E();
+    // The constants at the calling thread's precision, or to `digits` significant digits, from a cache shared
+    // by every thread that only computes what the largest precision so far does not cover
+    BigDecimal PI();
+    BigDecimal E();
+    BigDecimal LN2();
+    BigDecimal LN10();
+
+    BigDecimal PI(std::size_t digits);
+    BigDecimal E(std::size_t digits);
+    BigDecimal LN2(std::size_t digits);
+    BigDecimal LN10(std::size_t digits);
+
+    // The constants to `digits` significant digits by binary splitting of fast converging series
+    // (Chudnovsky for pi); threads = 0 uses every hardware thread
+    BigDecimal pi(std::size_t digits, unsigned threads = 0);
+    BigDecimal e(std::size_t digits, unsigned threads = 0);
+    BigDecimal ln2(std::size_t digits, unsigned threads = 0);
+    BigDecimal ln10(std::size_t digits, unsigned threads = 0);
+    BigDecimal zeta3(std::size_t digits, unsigned threads = 0);
+    BigDecimal catalan(std::size_t digits, unsigned threads = 0);
+
+    // Constant files (*.big_const) hold the plain decimal expansion, wrapped into lines
+    BigDecimal read_big_const(const std::string &path);
+    void write_big_const(const std::string &path, const BigDecimal &value, std::size_t line_width = 120);
 }
 
 #define BIG_PI  PI()
@@ -1,4 +1,13 @@
 #include "BigInteger.h"
+#include "Limbs.h"
+#include "ModContext.h"
+#include "CrtContext.h"
+#include "Kernels.h"
+
+#include <random>
+#include <future>
+#include <thread>
+#include <bit>
 
 
 /* * * * * * * * * * * Constructors * * * * * * * * * * */
@@ -24,6 +33,7 @@ BigInteger::BigInteger(int64_t nr)
 BigInteger::BigInteger(std::string &s)
 {
     digits = "";
+    sign = POSITIVE;
 
     int n = static_cast<int>(s.size());
     int end = 0;
@@ -55,6 +65,7 @@ BigInteger::BigInteger(std::string &s)
 BigInteger::BigInteger(const char *s)
 {
     digits = "";
+    sign = POSITIVE;
 
     int n = static_cast<int>(strlen(s));
     int end = 0;
@@ -155,9 +166,9 @@ bool abs_equals(const BigInteger &a, const BigInteger &b) {
 BigInteger BigInteger::mod_2() const
 {
     if (digits[0] % 2) {
-        return BigConstants::ZERO;
+        return BigConstants::ONE;
     }
-    return BigConstants::ONE;
+    return BigConstants::ZERO;
 }
 
 BigInteger BigInteger::mod_5() const
@@ -206,6 +217,192 @@ std::string BigInteger::hex() const
     return hex_repr;
 }
 
+// -------- Binary Representation --------
+// Below this many digits the conversion uses Horner's scheme
+static constexpr int CONVERT_THRESHOLD = 9 * 64;
+
+// Digits [lo, hi) as limbs, by Horner's scheme over blocks of 9 decimal digits
+static Limbs::Natural horner_limbs(const BigInteger::digit_string &digits, int lo, int hi)
+{
+    Limbs::Natural result;
+
+    int top = (hi - lo) % 9 ? (hi - lo) % 9 : 9;
+
+    for (int i = hi; i > lo; i -= top, top = 9)
+    {
+        Limbs::limb_t block = 0;
+
+        for (int j = i - 1; j >= i - top; --j) {
+            block = block * 10 + static_cast<Limbs::limb_t>(digits[j]);
+        }
+        uint64_t carry = block;
+
+        for (Limbs::limb_t &limb : result)
+        {
+            carry += static_cast<uint64_t>(limb) * 1000000000u;
+            limb = static_cast<Limbs::limb_t>(carry);
+            carry >>= Limbs::LIMB_BITS;
+        }
+        if (carry) result.push_back(static_cast<Limbs::limb_t>(carry));
+    }
+    Limbs::trim(result);
+    return result;
+}
+
+// Digits [lo, hi) as limbs, splitting off 9 * 2^j low digits; powers[j] = 10^(9 * 2^j)
+static Limbs::Natural range_limbs(const BigInteger::digit_string &digits, int lo, int hi,
+                                  std::vector<Limbs::Natural> &powers)
+{
+    if (hi - lo <= CONVERT_THRESHOLD) {
+        return horner_limbs(digits, lo, hi);
+    }
+    std::size_t j = 0;
+
+    while ((9 << (j + 1)) < hi - lo) {
+        ++j;
+    }
+    while (powers.size() <= j) {
+        powers.push_back(powers.empty() ? Limbs::Natural{ 1000000000u } : Limbs::sqr(powers.back()));
+    }
+    int mid = lo + (9 << j);
+
+    return Limbs::add(Limbs::mul(range_limbs(digits, mid, hi, powers), powers[j]),
+                      range_limbs(digits, lo, mid, powers));
+}
+
+// The lowest n decimal digits as limbs
+static Limbs::Natural low_limbs(const BigInteger::digit_string &digits, int n)
+{
+    std::vector<Limbs::Natural> powers;
+
+    return range_limbs(digits, 0, n, powers);
+}
+
+std::vector<uint32_t> BigInteger::limbs() const {
+    return low_limbs(digits, Length(*this));
+}
+
+BigInteger BigInteger::from_limbs(const std::vector<uint32_t> &limbs, bool negative)
+{
+    BigInteger result;
+
+    Limbs::Natural quotient(limbs);
+    Limbs::trim(quotient);
+
+    result.digits.clear();
+
+    // Repeated division by 10^9 yields 9 decimal digits per pass
+    while (!quotient.empty())
+    {
+        uint64_t rem = 0;
+
+        for (std::size_t i = quotient.size(); i-- > 0;)
+        {
+            uint64_t cur = (rem << Limbs::LIMB_BITS) | quotient[i];
+            quotient[i] = static_cast<Limbs::limb_t>(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        Limbs::trim(quotient);
+
+        for (int j = 0; j < 9; ++j)
+        {
+            result.digits.push_back(static_cast<char>(rem % 10));
+            rem /= 10;
+        }
+    }
+    while (result.digits.size() > 1 && !result.digits.back()) {
+        result.digits.pop_back();
+    }
+    if (result.digits.empty()) {
+        result.digits.push_back(0);
+    }
+    result.sign = (negative && !Null(result) ? NEGATIVE : POSITIVE);
+
+    return result;
+}
+
+// -------- Binary Size Queries --------
+
+// |n| lies in [m * 10^e, (m + 1) * 10^e) with m the leading (at most 15) digits
+static void leading_digits(const BigInteger::digit_string &digits, uint64_t &m, int &e)
+{
+    int n = static_cast<int>(digits.size());
+    int top = std::min(n, 15);
+
+    m = 0;
+    e = n - top;
+
+    for (int i = n - 1; i >= e; --i) {
+        m = m * 10 + static_cast<uint64_t>(digits[i]);
+    }
+}
+
+// Slack for the rounding error of e * log(10) in double precision
+static constexpr double LOG_SLACK = 1e-6;
+
+std::size_t BigInteger::bit_length() const
+{
+    uint64_t m;
+    int e;
+
+    leading_digits(digits, m, e);
+
+    if (!e) {
+        return static_cast<std::size_t>(std::bit_width(m));
+    }
+    // Exact unless |n| is too close to a power of two to tell from its leading digits
+    static const double LOG2_OF_10 = std::log2(10.0);
+
+    double lo = std::floor(std::log2(static_cast<double>(m)) + e * LOG2_OF_10 - LOG_SLACK);
+    double hi = std::floor(std::log2(static_cast<double>(m + 1)) + e * LOG2_OF_10 + LOG_SLACK);
+
+    if (lo == hi) {
+        return static_cast<std::size_t>(lo) + 1;
+    }
+    return Limbs::bit_length(limbs());
+}
+
+std::size_t BigInteger::count_trailing_zeros() const
+{
+    if (Null(*this)) {
+        return 0;
+    }
+    // 2^d divides 10^d, so the last d decimal digits agree with |n| modulo 2^d
+    int n = Length(*this);
+
+    for (int d = 18;; d *= 2)
+    {
+        d = std::min(d, n);
+
+        Limbs::Natural low = low_limbs(digits, d);
+
+        if (!low.empty())
+        {
+            std::size_t i = 0;
+
+            while (!low[i]) {
+                ++i;
+            }
+            std::size_t zeros = i * Limbs::LIMB_BITS + static_cast<std::size_t>(std::countr_zero(low[i]));
+
+            if (zeros < static_cast<std::size_t>(d) || d == n) {
+                return zeros;
+            }
+        }
+    }
+}
+
+std::size_t BigInteger::popcount() const
+{
+    std::size_t count = 0;
+
+    // Needs the full binary conversion
+    for (Limbs::limb_t limb : limbs()) {
+        count += static_cast<std::size_t>(std::popcount(limb));
+    }
+    return count;
+}
+
 
 /* * * * * * * * * * * Operator Overloading * * * * * * * * * * */
 
@@ -334,8 +531,7 @@ BigInteger::operator int64_t() const
         }
         else
         {
-            std::string buffer = digits.substr(digits.size() - 25, 25);
-            std::reverse(buffer.begin(), buffer.end());
+            std::string buffer(digits.rbegin(), digits.rbegin() + 25);
 
             for (char& c : buffer) {
                 c += '0';
@@ -381,6 +577,9 @@ BigInteger &operator += (BigInteger &a, const BigInteger& b)
 
     if (a.sign == b.sign)
     {
+        // Grow once, so a mapped buffer is not copied again for the final carry.
+        a.digits.reserve(std::max(n, m) + 1);
+
         if (m > n) {
             a.digits.append(m - n, 0);
         }
@@ -430,6 +629,9 @@ BigInteger &operator += (BigInteger &a, const BigInteger& b)
         }
         while(n > 1 && a.digits[n - 1] == 0)
             a.digits.pop_back(), n--;
+
+        if (Null(a))
+            a.sign = POSITIVE;
     }
     return a;
 }
@@ -445,6 +647,8 @@ BigInteger &operator -= (BigInteger&a, const BigInteger &b)
 
     if (a.sign != b.sign)
     {
+        a.digits.reserve(std::max(n, m) + 1);
+
         if (m > n) {
             a.digits.append(m - n, 0);
         }
@@ -468,12 +672,15 @@ BigInteger &operator -= (BigInteger&a, const BigInteger &b)
 
         const BigInteger *d;
 
+        // |a| < |b|: compute |b| - |a| and flip the sign
         if (n < m || abs_less(a, b))
         {
             c = b;
             swap(a, c);
             std::swap(m, n);
             d = &c;
+
+            a.sign = !a.sign;
         }
         else
             d = &b;
@@ -493,6 +700,9 @@ BigInteger &operator -= (BigInteger&a, const BigInteger &b)
         }
         while(n > 1 && a.digits[n - 1] == 0)
             a.digits.pop_back(), n--;
+
+        if (Null(a))
+            a.sign = POSITIVE;
     }
 
     return a;
@@ -530,23 +740,11 @@ bool operator > (const BigInteger&a, const BigInteger&b) {
 
 bool operator < (const BigInteger&a, const BigInteger&b)
 {
-    int n = Length(a);
-    int m = Length(b);
-
     if (a.sign != b.sign) {
         return a.sign == NEGATIVE;
     }
-
-    if(n != m) {
-        return n < m;
-    }
-
-    while(n--)
-    {
-        if (a.digits[n] != b.digits[n])
-            return a.digits[n] < b.digits[n];
-    }
-    return false;
+    // Between two negatives the larger magnitude is the smaller number
+    return (a.sign == NEGATIVE ? abs_less(b, a) : abs_less(a, b));
 }
 
 bool operator >= (const BigInteger&a, const BigInteger&b) {
@@ -558,6 +756,52 @@ bool operator <= (const BigInteger&a, const BigInteger&b) {
 }
 
 // -------- Multiplication and Division --------
+
+// Number of product columns accumulated at once; the accumulators stay resident in L1 cache.
+static constexpr std::size_t MUL_BLOCK = 2048;
+
+// Operands of at least this many digits are multiplied in packed base 10^9 form
+static constexpr std::size_t PACKED_MUL_DIGITS = 64;
+
+static constexpr uint32_t WORD_BASE = 1000000000u;
+
+// Base 10^9 words, least significant first, without leading zero words
+using Words = std::vector<uint32_t, MappedAllocator<uint32_t>>;
+
+using Decimal = Kernels::Radix<Words, WORD_BASE>;
+
+static Words pack(const BigInteger::digit_string &digits)
+{
+    Words w((digits.size() + 8) / 9, 0);
+
+    for (std::size_t i = digits.size(); i-- > 0;) {
+        w[i / 9] = w[i / 9] * 10 + static_cast<uint32_t>(digits[i]);
+    }
+    // Digits were accumulated most significant first within each word
+    Decimal::trim(w);
+    return w;
+}
+
+static void unpack(const Words &w, BigInteger::digit_string &digits)
+{
+    digits.assign(9 * w.size(), 0);
+
+    for (std::size_t i = 0; i < w.size(); ++i)
+    {
+        uint32_t word = w[i];
+
+        for (std::size_t j = 0; j < 9; ++j, word /= 10) {
+            digits[9 * i + j] = static_cast<char>(word % 10);
+        }
+    }
+    while (digits.size() > 1 && !digits.back()) {
+        digits.pop_back();
+    }
+    if (digits.empty()) {
+        digits.push_back(0);
+    }
+}
+
 BigInteger &operator *= (BigInteger &a, const BigInteger &b)
 {
     if(Null(a) || Null(b))
@@ -566,80 +810,96 @@ BigInteger &operator *= (BigInteger &a, const BigInteger &b)
         return a;
     }
 
-    int n = static_cast<int>(a.digits.size());
-    int m = static_cast<int>(b.digits.size());
-    int i, j, s, t;
+    const std::size_t n = a.digits.size();
+    const std::size_t m = b.digits.size();
 
-    std::vector<int> v(n + m, 0);
-
-    for (i = 0; i < n; i++)
+    if (std::min(n, m) >= PACKED_MUL_DIGITS)
     {
-        for (j = 0; j < m; j++) {
-            v[i + j] += (a.digits[i]) * (b.digits[j]);
-        }
+        Words x = pack(a.digits);
+
+        unpack(&a == &b ? Decimal::sqr(x) : Decimal::mul(x, pack(b.digits)), a.digits);
+
+        a.sign = (a.sign != b.sign ? NEGATIVE : POSITIVE);
+        return a;
     }
-    n += m;
+    const std::size_t columns = n + m - 1;
+
+    const char *x = a.digits.data();
+    const char *y = b.digits.data();
 
-    a.digits.resize(v.size());
+    BigInteger::digit_string product(n + m, 0);
 
-    for (i = 0, t = 0; i < n; i++)
+    uint64_t column[MUL_BLOCK];
+    uint64_t carry = 0;
+
+    // Columns are produced in blocks, left to right: for each block both operands are streamed
+    // sequentially once and the finished product digits are written out in order.
+    for (std::size_t k0 = 0; k0 < columns; k0 += MUL_BLOCK)
     {
-        s = t + v[i];
-        v[i] = s % 10;
-        t = s / 10;
-        a.digits[i] = static_cast<char>(v[i]);
+        const std::size_t k1 = std::min(k0 + MUL_BLOCK, columns);
+
+        std::fill(column, column + (k1 - k0), 0);
+
+        for (std::size_t i = (k0 >= m ? k0 - m + 1 : 0); i < n && i < k1; ++i)
+        {
+            const uint64_t xi = static_cast<uint64_t>(x[i]);
+
+            if (!xi) continue;
+
+            const std::size_t j0 = (k0 > i ? k0 - i : 0);
+            const std::size_t j1 = std::min(m, k1 - i);
+
+            uint64_t *col = column + (i + j0 - k0);
+
+            for (std::size_t j = j0; j < j1; ++j) {
+                col[j - j0] += xi * static_cast<uint64_t>(y[j]);
+            }
+        }
+
+        for (std::size_t k = k0; k < k1; ++k)
+        {
+            carry += column[k - k0];
+            product[k] = static_cast<char>(carry % 10);
+            carry /= 10;
+        }
     }
+    product[columns] = static_cast<char>(carry);
 
-    for (i = n - 1; i >= 1 && !v[i]; i--)
-        a.digits.pop_back();
+    while (product.size() > 1 && !product.back()) {
+        product.pop_back();
+    }
+    a.digits = std::move(product);
 
     a.sign = (a.sign != b.sign ? NEGATIVE : POSITIVE);
 
     return a;
 }
 
-BigInteger &operator /= (BigInteger& a, const BigInteger &b)
+// Truncating division, like the built-in integer operators: q = trunc(a / b), r = a - q b
+void BigInteger::divmod(const BigInteger &a, const BigInteger &b, BigInteger &q, BigInteger &r)
 {
-    if(Null(b)) {
+    if (Null(b)) {
         throw std::invalid_argument("Arithmetic Error: Division By 0");
     }
-    if(a < b)
-    {
-        a = BigConstants::ZERO;
-        return a;
-    }
-    if(a == b)
-    {
-        a = BigConstants::ONE;
-        return a;
-    }
-    int i, lgcat = 0, cc;
-    int n = Length(a);
+    Words quotient, remainder;
 
-    std::vector<int> cat(n, 0);
-    BigInteger t;
+    Decimal::divmod(pack(a.digits), pack(b.digits), quotient, remainder);
 
-    for (i = n - 1; t * 10 + a.digits[i]  < b;i--)
-    {
-        t *= 10;
-        t += a.digits[i] ;
-    }
-    for (; i >= 0; i--)
-    {
-        t = t * 10 + a.digits[i];
-        for (cc = 9; cc * b > t;cc--);
-        t -= cc * b;
-        cat[lgcat++] = cc;
-    }
-    a.digits.resize(cat.size());
+    const bool q_sign = (a.sign != b.sign ? NEGATIVE : POSITIVE);
+    const bool r_sign = a.sign;
 
-    for (i = 0; i < lgcat;i++)
-        a.digits[i] = static_cast<char>(cat[lgcat - i - 1]);
+    unpack(quotient, q.digits);
+    unpack(remainder, r.digits);
 
-    a.digits.resize(lgcat);
+    q.sign = Null(q) ? POSITIVE : q_sign;
+    r.sign = Null(r) ? POSITIVE : r_sign;
+}
 
-    a.sign = (a.sign != b.sign ? NEGATIVE : POSITIVE);
+BigInteger &operator /= (BigInteger& a, const BigInteger &b)
+{
+    BigInteger r;
 
+    BigInteger::divmod(a, b, a, r);
     return a;
 }
 
@@ -660,37 +920,9 @@ BigInteger operator / (const BigInteger &a, const BigInteger &b)
 // -------- Modulo --------
 BigInteger &operator %= (BigInteger &a, const BigInteger &b)
 {
-    if(Null(b)) {
-        throw std::invalid_argument("Arithmetic Error: Division By 0");
-    }
-    if(a < b) {
-        return a;
-    }
-    if(a == b)
-    {
-        a = BigConstants::ZERO;
-        return a;
-    }
-    int i, lgcat = 0, cc;
-    int n = Length(a);
-
-    std::vector<int> cat(n, 0);
+    BigInteger q;
 
-    BigInteger t;
-
-    for (i = n - 1; t * BigConstants::TEN + a.digits[i] < b;i--)
-    {
-        t *= BigConstants::TEN;
-        t += a.digits[i];
-    }
-    for (; i >= 0; i--)
-    {
-        t = t * BigConstants::TEN + a.digits[i];
-        for (cc = 9; cc * b > t; cc--);
-        t -= cc * b;
-        cat[lgcat++] = cc;
-    }
-    a = std::move(t);
+    BigInteger::divmod(a, b, q, a);
     return a;
 }
 
@@ -707,18 +939,21 @@ BigInteger &operator ^= (BigInteger &a, const BigInteger &b)
     if (b.sign == NEGATIVE) {
         throw std::invalid_argument("Positive Exponents only");
     }
-    BigInteger Exponent(b);
+    Limbs::Natural exponent = b.limbs();
+    std::size_t bits = Limbs::bit_length(exponent);
+
     BigInteger Base(a);
 
     a = BigConstants::ONE;
 
-    while(!Null(Exponent))
+    for (std::size_t i = 0; i < bits; ++i)
     {
-        if(Exponent[0] & 1) {
+        if (Limbs::test_bit(exponent, i)) {
             a *= Base;
         }
-        Base *= Base;
-        divide_by_2(Exponent);
+        if (i + 1 < bits) {
+            Base *= Base;
+        }
     }
 
     if (a.sign == NEGATIVE)
@@ -737,150 +972,1079 @@ BigInteger operator ^ (const BigInteger &a, const BigInteger &b)
     return temp;
 }
 
-// -------- Read and Write --------
-std::istream &operator >> (std::istream &is, BigInteger &a)
-{
-    std::string s;
-
-    is >> s;
+// -------- Bitwise Operations --------
 
-    int n = static_cast<int>(s.size());
+// digits *= m for m <= 2^32, in one pass
+static void mul_small(BigInteger::digit_string &digits, uint64_t m)
+{
+    uint64_t carry = 0;
 
-    for (int i = n - 1; i >= 0; i--)
+    for (char &digit : digits)
     {
-        if(!isdigit(s[i]))
-        {
-            std::string err_message;
-
-            err_message = "Input Error: Could not parse \"";
-            err_message += s;
-            err_message += "\" to integer value.";
-
-            throw std::invalid_argument(err_message);
-        }
-        a.digits[n - i - 1] = s[i];
+        carry += static_cast<uint64_t>(digit) * m;
+        digit = static_cast<char>(carry % 10);
+        carry /= 10;
+    }
+    for (; carry; carry /= 10) {
+        digits.push_back(static_cast<char>(carry % 10));
     }
-    return is;
 }
 
-std::ostream &operator << (std::ostream &os, const BigInteger &a)
+// digits /= d for d <= 2^32, in one pass; returns the remainder
+static uint64_t div_small(BigInteger::digit_string &digits, uint64_t d)
 {
-    if (a.sign == NEGATIVE) {
-        os << '-';
+    uint64_t rem = 0;
+
+    for (std::size_t i = digits.size(); i-- > 0;)
+    {
+        rem = rem * 10 + static_cast<uint64_t>(digits[i]);
+        digits[i] = static_cast<char>(rem / d);
+        rem %= d;
     }
-    for (int i = static_cast<int>(a.digits.size()) - 1; i >= 0; i--) {
-        os << static_cast<short>(a.digits[i]);
+    while (digits.size() > 1 && !digits.back()) {
+        digits.pop_back();
     }
-    return os;
+    return rem;
 }
 
-// -------- Square Root Function --------
-BigInteger BigInteger::sqrt(const BigInteger &n)
+static BigInteger power_of_2(std::size_t k)
 {
-    if (n.sign == NEGATIVE) {
-        throw std::invalid_argument("Arithmetic Error: sqrt(x) not difined for negative x.");
+    if (k < 63) {
+        return static_cast<int64_t>(1) << k;
     }
-    BigInteger left(1), right(n), v(1), mid, prod;
+    return BigConstants::TWO ^ BigInteger(static_cast<int64_t>(k));
+}
 
-    divide_by_2(right);
+// Short shifts are single passes over the digits. Longer left shifts multiply by 2^k,
+// longer right shifts go through the binary form.
+static constexpr std::size_t DECIMAL_SHIFT_LIMIT = 64;
 
-    while(left <= right)
+BigInteger &operator <<= (BigInteger &a, std::size_t k)
+{
+    if (Null(a) || !k) {
+        return a;
+    }
+    if (k > DECIMAL_SHIFT_LIMIT) {
+        return a *= power_of_2(k);
+    }
+    for (std::size_t s; k; k -= s)
     {
-        mid += left;
-        mid += right;
+        s = std::min<std::size_t>(k, 32);
+        mul_small(a.digits, static_cast<uint64_t>(1) << s);
+    }
+    return a;
+}
 
-        divide_by_2(mid);
+// Floor division by 2^k, as an arithmetic shift of the two's-complement form
+BigInteger &operator >>= (BigInteger &a, std::size_t k)
+{
+    if (Null(a) || !k) {
+        return a;
+    }
+    bool negative = (a.sign == NEGATIVE);
+    bool inexact = false;
 
-        prod = (mid * mid);
+    if (k > DECIMAL_SHIFT_LIMIT)
+    {
+        Limbs::Natural m = a.limbs();
 
-        if(prod <= n)
+        inexact = !Limbs::truncate(m, k).empty();
+        a = BigInteger::from_limbs(Limbs::shr(m, k));
+    }
+    else
+    {
+        for (std::size_t s; k; k -= s)
         {
-            v = mid;
-            ++mid;
-            left = std::move(mid);
+            s = std::min<std::size_t>(k, 32);
+            inexact |= div_small(a.digits, static_cast<uint64_t>(1) << s) != 0;
         }
-        else{
-            --mid;
-            right = std::move(mid);
-        }
-        mid = BigConstants::ZERO;
     }
-    return v;
+    if (Null(a))
+    {
+        a.sign = POSITIVE;
+        return negative ? a = static_cast<int64_t>(-1) : a;
+    }
+    a.sign = negative ? NEGATIVE : POSITIVE;
+
+    // -ceil(|a| / 2^k)
+    if (negative && inexact) {
+        --a;
+    }
+    return a;
 }
 
-BigInteger BigInteger::log2(const BigInteger &n)
+BigInteger operator << (const BigInteger &a, std::size_t k)
 {
-    if (n.sign == NEGATIVE) {
-        throw std::invalid_argument("Arithmetic Error: log2(x) not defined for negative x.");
-    }
-    return { static_cast<int64_t>(LOG2_10 * (double)(n.digits.size() - 1)) };
+    BigInteger result(a);
+    return result <<= k;
 }
 
-BigInteger BigInteger::log10(const BigInteger &n)
+BigInteger operator >> (const BigInteger &a, std::size_t k)
 {
-    if (n.sign == NEGATIVE) {
-        throw std::invalid_argument("Arithmetic Error: log10(x) not defined for negative x.");
-    }
-    return { static_cast<int64_t>(n.digits.size() - 1) };
+    BigInteger result(a);
+    return result >>= k;
 }
 
-BigInteger BigInteger::abs(const BigInteger &n)
+// a mod 2^k from the last k decimal digits, since 2^k divides 10^k
+static Limbs::Natural low_bits(const BigInteger::digit_string &digits, bool negative, std::size_t k)
 {
-    BigInteger abs_n(n);
+    int n = static_cast<int>(std::min<std::size_t>(k, digits.size()));
 
-    abs_n.sign = POSITIVE;
+    Limbs::Natural low = Limbs::truncate(low_limbs(digits, n), k);
 
-    return abs_n;
+    if (negative && !low.empty()) {
+        low = Limbs::sub(Limbs::shl({ 1 }, k), low);
+    }
+    return low;
 }
 
-BigInteger BigInteger::catalan(int n)
+static BigInteger bitwise(const BigInteger &a, const BigInteger &b, Limbs::BitOp op)
+{
+    Limbs::Signed r = Limbs::bitwise({ a.limbs(), a < BigConstants::ZERO },
+                                     { b.limbs(), b < BigConstants::ZERO }, op);
+
+    return BigInteger::from_limbs(r.mag, r.negative);
+}
+
+BigInteger operator & (const BigInteger &a, const BigInteger &b)
 {
-    BigInteger a(1), b;
-    BigInteger N(n);
+    // Masking with a non-negative operand only reads the other operand's low digits
+    const BigInteger *mask = nullptr, *other = nullptr;
 
-    for (BigInteger i = 2; i <= N; ++i)
-        a *= i;
+    if (b.sign == POSITIVE && (a.sign == NEGATIVE || Length(b) <= Length(a))) {
+        mask = &b, other = &a;
+    }
+    else if (a.sign == POSITIVE) {
+        mask = &a, other = &b;
+    }
+    if (!mask) {
+        return bitwise(a, b, Limbs::BitOp::AND);
+    }
+    Limbs::Natural m = mask->limbs();
+    Limbs::Signed r = Limbs::bitwise({ m }, { low_bits(other->digits, other->sign == NEGATIVE, Limbs::bit_length(m)) }, Limbs::BitOp::AND);
 
-    b = a;
+    return BigInteger::from_limbs(r.mag);
+}
 
-    BigInteger _2n = BigConstants::TWO * n;
+BigInteger operator | (const BigInteger &a, const BigInteger &b) {
+    return bitwise(a, b, Limbs::BitOp::OR);
+}
 
-    for (BigInteger i = n + 1; i <= _2n; ++i)
-        b *= i;
+BigInteger BigInteger::xor_bits(const BigInteger &a, const BigInteger &b) {
+    return bitwise(a, b, Limbs::BitOp::XOR);
+}
 
-    a *= a;
-    a *= (n + 1);
-    b /= a;
+BigInteger &operator &= (BigInteger &a, const BigInteger &b) {
+    return a = a & b;
+}
 
-    return b;
+BigInteger &operator |= (BigInteger &a, const BigInteger &b) {
+    return a = a | b;
 }
 
-BigInteger BigInteger::fibonacci(int n)
+// ~a = -a - 1
+BigInteger operator ~ (const BigInteger &a)
 {
-    BigInteger a(1), b(1), c;
+    if (Null(a)) {
+        return static_cast<int64_t>(-1);
+    }
+    BigInteger result(a);
 
-    if(!n) return c;
+    result.sign = !result.sign;
+    --result;
 
-    n--;
+    return result;
+}
 
-    while(n--)
+bool BigInteger::test_bit(std::size_t i) const {
+    return Limbs::test_bit(low_bits(digits, sign == NEGATIVE, i + 1), i);
+}
+
+// Setting a clear bit adds 2^i to the two's-complement value, clearing a set bit subtracts it
+void BigInteger::set_bit(std::size_t i)
+{
+    if (!test_bit(i)) {
+        *this += power_of_2(i);
+    }
+}
+
+void BigInteger::clear_bit(std::size_t i)
+{
+    if (test_bit(i)) {
+        *this -= power_of_2(i);
+    }
+}
+
+// -------- Read and Write --------
+std::istream &operator >> (std::istream &is, BigInteger &a)
+{
+    std::string s;
+
+    is >> s;
+
+    int n = static_cast<int>(s.size());
+
+    for (int i = n - 1; i >= 0; i--)
+    {
+        if(!isdigit(s[i]))
+        {
+            std::string err_message;
+
+            err_message = "Input Error: Could not parse \"";
+            err_message += s;
+            err_message += "\" to integer value.";
+
+            throw std::invalid_argument(err_message);
+        }
+        a.digits[n - i - 1] = s[i];
+    }
+    return is;
+}
+
+std::ostream &operator << (std::ostream &os, const BigInteger &a)
+{
+    if (a.sign == NEGATIVE) {
+        os << '-';
+    }
+    for (int i = static_cast<int>(a.digits.size()) - 1; i >= 0; i--) {
+        os << static_cast<short>(a.digits[i]);
+    }
+    return os;
+}
+
+// -------- Logarithms --------
+BigInteger BigInteger::log2(const BigInteger &n) {
+    return static_cast<int64_t>(ilog2(n));
+}
+
+BigInteger BigInteger::log10(const BigInteger &n) {
+    return static_cast<int64_t>(ilog10(n));
+}
+
+std::size_t BigInteger::ilog2(const BigInteger &n)
+{
+    if (n.sign == NEGATIVE || Null(n)) {
+        throw std::invalid_argument("Arithmetic Error: log(x) not defined for x <= 0.");
+    }
+    return n.bit_length() - 1;
+}
+
+std::size_t BigInteger::ilog10(const BigInteger &n)
+{
+    if (n.sign == NEGATIVE || Null(n)) {
+        throw std::invalid_argument("Arithmetic Error: log(x) not defined for x <= 0.");
+    }
+    return static_cast<std::size_t>(Length(n) - 1);
+}
+
+std::size_t BigInteger::ilog(const BigInteger &n, const BigInteger &base)
+{
+    if (n.sign == NEGATIVE || Null(n)) {
+        throw std::invalid_argument("Arithmetic Error: log(x) not defined for x <= 0.");
+    }
+    if (base.sign == NEGATIVE || base < BigConstants::TWO) {
+        throw std::invalid_argument("Arithmetic Error: log_b(x) requires b >= 2.");
+    }
+    if (base == BigConstants::TEN) {
+        return ilog10(n);
+    }
+    if (base == BigConstants::TWO) {
+        return ilog2(n);
+    }
+    // Bounds on log10 of both operands from their leading digits
+    uint64_t m;
+    int e;
+
+    leading_digits(n.digits, m, e);
+
+    double n_lo = std::log10(static_cast<double>(m)) + e - LOG_SLACK;
+    double n_hi = std::log10(static_cast<double>(e ? m + 1 : m)) + e + LOG_SLACK;
+
+    leading_digits(base.digits, m, e);
+
+    double b_lo = std::log10(static_cast<double>(m)) + e - LOG_SLACK;
+    double b_hi = std::log10(static_cast<double>(e ? m + 1 : m)) + e + LOG_SLACK;
+
+    auto k = static_cast<std::size_t>(std::max(0.0, std::floor(n_lo / b_hi)));
+    auto k_hi = static_cast<std::size_t>(std::floor(n_hi / b_lo));
+
+    if (k == k_hi) {
+        return k;
+    }
+    // Ambiguous: settle with exact powers
+    BigInteger power = base ^ BigInteger(static_cast<int64_t>(k + 1));
+
+    while (k < k_hi && power <= n)
+    {
+        ++k;
+        power *= base;
+    }
+    return k;
+}
+
+// -------- Square Root Function --------
+BigInteger BigInteger::sqrt(const BigInteger &n) {
+    return isqrt(n);
+}
+
+BigInteger BigInteger::isqrt(const BigInteger &n)
+{
+    if (n.sign == NEGATIVE) {
+        throw std::invalid_argument("Arithmetic Error: sqrt(x) not defined for negative x.");
+    }
+    return from_limbs(Limbs::isqrt(n.limbs()));
+}
+
+BigInteger::SqrtRem BigInteger::isqrt_rem(const BigInteger &n)
+{
+    if (n.sign == NEGATIVE) {
+        throw std::invalid_argument("Arithmetic Error: sqrt(x) not defined for negative x.");
+    }
+    Limbs::Natural s, r;
+
+    Limbs::sqrt_rem(n.limbs(), s, r);
+
+    return { from_limbs(s), from_limbs(r) };
+}
+
+BigInteger BigInteger::iroot(const BigInteger &n, int k)
+{
+    if (k < 1) {
+        throw std::invalid_argument("Arithmetic Error: iroot(x, k) requires k >= 1.");
+    }
+    if (n.sign == NEGATIVE && !(k & 1)) {
+        throw std::invalid_argument("Arithmetic Error: iroot(x, k) not defined for negative x and even k.");
+    }
+    return from_limbs(Limbs::iroot(n.limbs(), static_cast<unsigned>(k)), n.sign == NEGATIVE);
+}
+
+BigInteger BigInteger::abs(const BigInteger &n)
+{
+    BigInteger abs_n(n);
+
+    abs_n.sign = POSITIVE;
+
+    return abs_n;
+}
+
+// -------- Modular Exponentiation --------
+BigInteger BigInteger::powmod(const BigInteger &base, const BigInteger &exp, const BigInteger &mod)
+{
+    if (mod.sign == NEGATIVE || Null(mod)) {
+        throw std::invalid_argument("Arithmetic Error: powmod(b, e, m) requires m > 0.");
+    }
+    if (mod == BigConstants::ONE) {
+        return BigConstants::ZERO;
+    }
+    ModContext ctx(mod);
+
+    return ctx.to_integer(ctx.pow(ctx.to_residue(base), exp));
+}
+
+// -------- Greatest Common Divisor --------
+BigInteger BigInteger::gcd(const BigInteger &a, const BigInteger &b) {
+    return from_limbs(Limbs::gcd(a.limbs(), b.limbs()));
+}
+
+BigInteger BigInteger::lcm(const BigInteger &a, const BigInteger &b)
+{
+    if (Null(a) || Null(b)) {
+        return BigConstants::ZERO;
+    }
+    Limbs::Natural x = a.limbs();
+    Limbs::Natural y = b.limbs();
+    Limbs::Natural q, r;
+
+    Limbs::divmod(x, Limbs::gcd(x, y), q, r);
+
+    return from_limbs(Limbs::mul(q, y));
+}
+
+BigInteger::ExtendedGcd BigInteger::gcd_ext(const BigInteger &a, const BigInteger &b)
+{
+    Limbs::Signed s, t;
+    Limbs::Natural g = Limbs::gcd_ext(a.limbs(), b.limbs(), s, t);
+
+    return {
+        from_limbs(g),
+        from_limbs(s.mag, s.negative != (a.sign == NEGATIVE)),
+        from_limbs(t.mag, t.negative != (b.sign == NEGATIVE))
+    };
+}
+
+// -------- Modular Inverse --------
+std::optional<BigInteger> BigInteger::modinv(const BigInteger &a, const BigInteger &m)
+{
+    if (m.sign == NEGATIVE || Null(m)) {
+        throw std::invalid_argument("Arithmetic Error: modinv(a, m) requires m > 0.");
+    }
+    Limbs::Natural n = m.limbs();
+    Limbs::Natural x = Limbs::mod(a.limbs(), n);
+
+    if (a.sign == NEGATIVE && !x.empty()) {
+        x = Limbs::sub(n, x);
+    }
+    if (n.size() == 1 && n[0] == 1) {
+        return BigConstants::ZERO;
+    }
+    // m = 2^k: Hensel lifting instead of a GCD
+    std::size_t bits = Limbs::bit_length(n);
+
+    if (Limbs::compare(n, Limbs::shl({ 1 }, bits - 1)) == 0)
+    {
+        if (x.empty() || !(x[0] & 1)) {
+            return std::nullopt;
+        }
+        return from_limbs(Limbs::inverse_pow2(x, bits - 1));
+    }
+    Limbs::Signed s, t;
+    Limbs::Natural g = Limbs::gcd_ext(x, n, s, t);
+
+    if (g.size() != 1 || g[0] != 1) {
+        return std::nullopt;
+    }
+    return from_limbs(s.negative ? Limbs::sub(n, s.mag) : s.mag);
+}
+
+// -------- Primality --------
+static constexpr Limbs::limb_t TRIAL_LIMIT = 2048;
+
+struct PrimeBatch
+{
+    Limbs::limb_t product;
+    std::vector<Limbs::limb_t> primes;
+};
+
+// Odd primes below TRIAL_LIMIT, grouped so that each product fits in one limb
+static const std::vector<PrimeBatch> &prime_batches()
+{
+    static const std::vector<PrimeBatch> batches = [] {
+        std::vector<bool> composite(TRIAL_LIMIT, false);
+        std::vector<PrimeBatch> result;
+
+        for (Limbs::limb_t p = 3; p < TRIAL_LIMIT; p += 2)
+        {
+            if (composite[p]) {
+                continue;
+            }
+            for (Limbs::limb_t q = p * p; q < TRIAL_LIMIT; q += 2 * p) {
+                composite[q] = true;
+            }
+            if (result.empty() || static_cast<Limbs::dlimb_t>(result.back().product) * p > UINT32_MAX) {
+                result.push_back({ 1, {} });
+            }
+            result.back().product *= p;
+            result.back().primes.push_back(p);
+        }
+        return result;
+    }();
+
+    return batches;
+}
+
+// Jacobi symbol (d / n) for odd n > 0
+static int jacobi(int64_t d, const Limbs::Natural &n)
+{
+    int result = 1;
+
+    // (-1 / n) = (-1)^((n - 1) / 2)
+    if (d < 0)
+    {
+        d = -d;
+
+        if ((n[0] & 3) == 3) {
+            result = -result;
+        }
+    }
+    uint64_t a = static_cast<uint64_t>(d);
+
+    // (2 / n) = -1 iff n = 3, 5 (mod 8)
+    while (a && !(a & 1))
+    {
+        a >>= 1;
+
+        if ((n[0] & 7) == 3 || (n[0] & 7) == 5) {
+            result = -result;
+        }
+    }
+    if (a == 1) {
+        return result;
+    }
+    // Quadratic reciprocity, then the symbol is small
+    if ((a & 3) == 3 && (n[0] & 3) == 3) {
+        result = -result;
+    }
+    uint64_t b = Limbs::mod_small(n, static_cast<Limbs::limb_t>(a));
+
+    while (b)
+    {
+        while (!(b & 1))
+        {
+            b >>= 1;
+
+            if ((a & 7) == 3 || (a & 7) == 5) {
+                result = -result;
+            }
+        }
+        std::swap(a, b);
+
+        if ((a & 3) == 3 && (b & 3) == 3) {
+            result = -result;
+        }
+        b %= a;
+    }
+    return a == 1 ? result : 0;
+}
+
+// Strong probable prime test to base a, with n - 1 = d * 2^s
+static bool miller_rabin(const ModContext &ctx, const Limbs::Natural &d, std::size_t s, const ModContext::Residue &a)
+{
+    ModContext::Residue one = ctx.one();
+    ModContext::Residue minus_one = ctx.neg(one);
+
+    ModContext::Residue x = ctx.pow(a, d);
+
+    if (x == one || x == minus_one) {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; ++r)
+    {
+        x = ctx.sqr(x);
+
+        if (x == minus_one) {
+            return true;
+        }
+        if (x == one) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// Strong Lucas probable prime test with Selfridge's parameters P = 1, Q = (1 - D) / 4
+static bool strong_lucas(const ModContext &ctx, const Limbs::Natural &n)
+{
+    int64_t d = 5;
+
+    while (true)
+    {
+        int j = jacobi(d, n);
+
+        if (j == -1) {
+            break;
+        }
+        // A common factor, unless n = |D| itself
+        if (j == 0 && !(n.size() == 1 && n[0] == static_cast<Limbs::limb_t>(d < 0 ? -d : d))) {
+            return false;
+        }
+        // No D with (D / n) = -1 exists when n is a square
+        if (d == 13)
+        {
+            Limbs::Natural root = Limbs::isqrt(n);
+
+            if (Limbs::compare(Limbs::sqr(root), n) == 0) {
+                return false;
+            }
+        }
+        d = d > 0 ? -(d + 2) : -d + 2;
+    }
+    ModContext::Residue D = ctx.to_residue(BigInteger(d));
+    ModContext::Residue Q = ctx.to_residue(BigInteger((1 - d) / 4));
+
+    // n + 1 = k * 2^s with k odd
+    Limbs::Natural k = Limbs::add(n, { 1 });
+    std::size_t s = 0;
+
+    while (!Limbs::test_bit(k, s)) {
+        ++s;
+    }
+    k = Limbs::shr(k, s);
+
+    // U_1 = 1, V_1 = P = 1; doubling U_2i = U_i V_i, V_2i = V_i^2 - 2 Q^i
+    ModContext::Residue U = ctx.one();
+    ModContext::Residue V = ctx.one();
+    ModContext::Residue Qk = Q;
+
+    for (std::size_t i = Limbs::bit_length(k) - 1; i-- > 0;)
+    {
+        U = ctx.mul(U, V);
+        V = ctx.sub(ctx.sqr(V), ctx.add(Qk, Qk));
+        Qk = ctx.sqr(Qk);
+
+        if (Limbs::test_bit(k, i))
+        {
+            // U_(i+1) = (P U_i + V_i) / 2, V_(i+1) = (D U_i + P V_i) / 2
+            ModContext::Residue u = ctx.half(ctx.add(U, V));
+
+            V = ctx.half(ctx.add(ctx.mul(D, U), V));
+            U = std::move(u);
+            Qk = ctx.mul(Qk, Q);
+        }
+    }
+    if (U.empty() || V.empty()) {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; ++r)
+    {
+        V = ctx.sub(ctx.sqr(V), ctx.add(Qk, Qk));
+
+        if (V.empty()) {
+            return true;
+        }
+        Qk = ctx.sqr(Qk);
+    }
+    return false;
+}
+
+bool BigInteger::is_probable_prime(const BigInteger &number, int rounds)
+{
+    if (number.sign == NEGATIVE) {
+        return false;
+    }
+    Limbs::Natural n = number.limbs();
+
+    if (n.empty() || (n.size() == 1 && n[0] < 4)) {
+        return n.size() == 1 && n[0] >= 2;
+    }
+    if (!(n[0] & 1)) {
+        return false;
+    }
+    // One multi-precision remainder per batch of small primes
+    for (const PrimeBatch &batch : prime_batches())
+    {
+        Limbs::limb_t r = Limbs::mod_small(n, batch.product);
+
+        for (Limbs::limb_t p : batch.primes)
+        {
+            if (r % p == 0) {
+                return n.size() == 1 && n[0] == p;
+            }
+        }
+    }
+    // No factor below TRIAL_LIMIT and n < TRIAL_LIMIT^2
+    if (n.size() == 1 && n[0] < TRIAL_LIMIT * TRIAL_LIMIT) {
+        return true;
+    }
+    ModContext ctx(number);
+
+    // n - 1 = d * 2^s with d odd
+    Limbs::Natural d = Limbs::sub(n, { 1 });
+    std::size_t s = 0;
+
+    while (!Limbs::test_bit(d, s)) {
+        ++s;
+    }
+    d = Limbs::shr(d, s);
+
+    if (!miller_rabin(ctx, d, s, ctx.to_residue(BigConstants::TWO)) || !strong_lucas(ctx, n)) {
+        return false;
+    }
+    // Random bases in [2, n - 2]
+    static thread_local std::mt19937 engine{ std::random_device{}() };
+
+    Limbs::Natural range = Limbs::sub(n, { 3 });
+
+    for (int i = 0; i < rounds; ++i)
+    {
+        Limbs::Natural a(n.size());
+
+        for (Limbs::limb_t &limb : a) {
+            limb = static_cast<Limbs::limb_t>(engine());
+        }
+        Limbs::trim(a);
+        a = Limbs::add(Limbs::mod(a, range), { 2 });
+
+        if (!miller_rabin(ctx, d, s, ctx.to_residue(from_limbs(a)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BigInteger BigInteger::fibonacci(int n) {
+    return fibonacci_pair(n).first;
+}
+
+std::pair<BigInteger, BigInteger> BigInteger::fibonacci_pair(int n)
+{
+    // F(-k) = (-1)^(k + 1) F(k)
+    if (n < 0)
+    {
+        std::pair<BigInteger, BigInteger> p = fibonacci_pair(-(n + 1));
+
+        if (!(n & 1)) {
+            p.second = BigConstants::ZERO - p.second;
+        }
+        else {
+            p.first = BigConstants::ZERO - p.first;
+        }
+        return { std::move(p.second), std::move(p.first) };
+    }
+    // Fast doubling on (F(k - 1), F(k)) up to k = n + 1, two squarings per bit:
+    // F(2k - 1) = F(k)^2 + F(k - 1)^2, F(2k + 1) = 4 F(k)^2 - F(k - 1)^2 + 2 (-1)^k
+    const auto k = static_cast<uint64_t>(n) + 1;
+
+    BigInteger f0 = BigConstants::ZERO;
+    BigInteger f1 = BigConstants::ONE;
+
+    bool odd = true;
+
+    for (int i = std::bit_width(k) - 1; i-- > 0;)
+    {
+        BigInteger s0(f0), s1(f1);
+
+        s0 *= s0;
+        s1 *= s1;
+
+        BigInteger f_lo = s0 + s1;
+        BigInteger f_hi = (s1 << 2) - s0;
+
+        if (odd) {
+            f_hi -= BigConstants::TWO;
+        }
+        else {
+            f_hi += BigConstants::TWO;
+        }
+        odd = (k >> i) & 1;
+
+        if (odd)
+        {
+            f0 = f_hi - f_lo;
+            f1 = std::move(f_hi);
+        }
+        else
+        {
+            f1 = f_hi - f_lo;
+            f0 = std::move(f_lo);
+        }
+    }
+    return { std::move(f0), std::move(f1) };
+}
+
+BigInteger BigInteger::lucas(int n)
+{
+    // L(-k) = (-1)^k L(k)
+    if (n < 0)
+    {
+        BigInteger l = lucas(-n);
+        return (n & 1) ? BigConstants::ZERO - l : l;
+    }
+    // L(n) = F(n - 1) + F(n + 1) = 2 F(n + 1) - F(n)
+    std::pair<BigInteger, BigInteger> p = fibonacci_pair(n);
+
+    return (p.second << 1) - p.first;
+}
+
+std::pair<BigInteger, BigInteger> BigInteger::lucas_sequence(const BigInteger &P, const BigInteger &Q, int n)
+{
+    if (n < 0) {
+        throw std::invalid_argument("Arithmetic Error: lucas_sequence(P, Q, n) requires n >= 0.");
+    }
+    if (!n) {
+        return { BigConstants::ZERO, BigConstants::TWO };
+    }
+    const BigInteger D = P * P - (Q << 2);
+
+    // Doubling: U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+    // Increment: U_k+1 = (P U_k + V_k) / 2, V_k+1 = (D U_k + P V_k) / 2
+    BigInteger U = BigConstants::ONE;
+    BigInteger V = P;
+    BigInteger Qk = Q;
+
+    for (int i = std::bit_width(static_cast<unsigned>(n)) - 1; i-- > 0;)
+    {
+        U *= V;
+        V *= V;
+        V -= Qk << 1;
+        Qk *= Qk;
+
+        if ((n >> i) & 1)
+        {
+            BigInteger u = (P * U + V) >> 1;
+
+            V = (D * U + P * V) >> 1;
+            U = std::move(u);
+            Qk *= Q;
+        }
+    }
+    return { std::move(U), std::move(V) };
+}
+
+// -------- Products --------
+
+// Below this many values a subtree is not worth a thread of its own
+static constexpr std::size_t PRODUCT_THREAD_MIN = 64;
+
+static BigInteger product_of(const BigInteger *values, std::size_t n, unsigned threads)
+{
+    if (n == 0) {
+        return BigConstants::ONE;
+    }
+    if (n == 1) {
+        return values[0];
+    }
+    const std::size_t half = n / 2;
+
+    // The upper levels of the tree run their left halves concurrently
+    if (threads > 1 && n >= PRODUCT_THREAD_MIN)
     {
-        c = a + b;
-        b = std::move(a);
-        a = std::move(c);
+        auto left = std::async(std::launch::async, product_of, values, half, threads / 2);
+
+        BigInteger right = product_of(values + half, n - half, threads - threads / 2);
+        BigInteger result = left.get();
+
+        return result *= right;
     }
-    return b;
+    BigInteger result = product_of(values, half, 1);
+
+    return result *= product_of(values + half, n - half, 1);
 }
 
+BigInteger BigInteger::product(const std::vector<BigInteger> &values, unsigned threads)
+{
+    if (!threads) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return product_of(values.data(), values.size(), threads);
+}
+
+// Packs small factors into words of up to 18 digits, the leaves of a product tree
+class WordPacker
+{
+private:
+    static constexpr uint64_t WORD_LIMIT = 1000000000000000000ull;
+
+    std::vector<BigInteger> words;
+    uint64_t word = 1;
+
+public:
+    // Requires 0 < f < 2^63
+    void push(uint64_t f)
+    {
+        if (word > WORD_LIMIT / f)
+        {
+            words.emplace_back(static_cast<int64_t>(word));
+            word = 1;
+        }
+        word *= f;
+    }
+
+    std::vector<BigInteger> finish()
+    {
+        words.emplace_back(static_cast<int64_t>(word));
+        word = 1;
+
+        return std::move(words);
+    }
+};
+
+BigInteger BigInteger::product_range(int64_t lo, int64_t hi, unsigned threads)
+{
+    if (lo > hi) {
+        return BigConstants::ONE;
+    }
+    if (lo <= 0 && hi >= 0) {
+        return BigConstants::ZERO;
+    }
+    // A range of negatives is the mirrored positive range, negative for an odd count
+    if (hi < 0)
+    {
+        BigInteger result = product_range(-hi, -lo, threads);
+
+        if ((hi - lo) % 2 == 0) {
+            result = BigConstants::ZERO - result;
+        }
+        return result;
+    }
+    WordPacker packer;
+
+    for (auto i = static_cast<uint64_t>(lo); i <= static_cast<uint64_t>(hi); ++i) {
+        packer.push(i);
+    }
+    return product(packer.finish(), threads);
+}
+
+// -------- Remainder trees --------
+
+std::vector<BigInteger> BigInteger::remainders(const BigInteger &x, const std::vector<BigInteger> &moduli)
+{
+    if (moduli.empty()) {
+        return {};
+    }
+    return CrtContext(moduli).reduce(x);
+}
+
+BigInteger BigInteger::crt(const std::vector<BigInteger> &residues, const std::vector<BigInteger> &moduli)
+{
+    if (moduli.empty()) {
+        return BigConstants::ZERO;
+    }
+    return CrtContext(moduli).reconstruct(residues);
+}
+
+// -------- Factorial --------
+
+// Primes up to n by the sieve of Eratosthenes over odd numbers
+static std::vector<uint32_t> primes_up_to(uint32_t n)
+{
+    std::vector<uint32_t> primes;
+
+    if (n < 2) {
+        return primes;
+    }
+    primes.push_back(2);
+
+    // composite[i] refers to 2i + 1
+    std::vector<bool> composite(n / 2 + 1, false);
+
+    for (uint32_t i = 1; 2 * i + 1 <= n; ++i)
+    {
+        if (composite[i]) {
+            continue;
+        }
+        const uint64_t p = 2 * i + 1;
+
+        primes.push_back(static_cast<uint32_t>(p));
+
+        for (uint64_t q = p * p; q <= n; q += 2 * p) {
+            composite[q / 2] = true;
+        }
+    }
+    return primes;
+}
+
+// Product of word-sized factors
+static BigInteger product_tree(const std::vector<uint64_t> &factors)
+{
+    WordPacker packer;
+
+    for (uint64_t f : factors) {
+        packer.push(f);
+    }
+    return BigInteger::product(packer.finish());
+}
+
+// Odd part of the swinging factorial n! / (floor(n/2)!)^2: each odd prime p
+// appears with exponent sum_i (floor(n / p^i) mod 2), and p^e <= n.
+static BigInteger odd_swing(uint32_t n, const std::vector<uint32_t> &primes)
+{
+    std::vector<uint64_t> factors;
+
+    for (std::size_t i = 1; i < primes.size() && primes[i] <= n; ++i)
+    {
+        const uint32_t p = primes[i];
+        uint64_t power = 1;
+
+        for (uint32_t q = n / p; q; q /= p)
+        {
+            if (q & 1) {
+                power *= p;
+            }
+        }
+        if (power > 1) {
+            factors.push_back(power);
+        }
+    }
+    return product_tree(factors);
+}
+
+// Odd part of n!: oddfact(n) = oddfact(floor(n/2))^2 * odd_swing(n)
+static BigInteger odd_factorial(uint32_t n, const std::vector<uint32_t> &primes)
+{
+    if (n < 3) {
+        return BigConstants::ONE;
+    }
+    BigInteger result = odd_factorial(n / 2, primes);
+
+    result *= result;
+    result *= odd_swing(n, primes);
+
+    return result;
+}
+
+// Luschny's prime-swing algorithm; the 2-adic part n - popcount(n) is applied as one shift
 BigInteger BigInteger::factorial(int n)
 {
-    BigInteger f(1);
-    BigInteger N(n);
+    if (n < 0) {
+        throw std::invalid_argument("Arithmetic Error: factorial(n) requires n >= 0.");
+    }
+    const auto m = static_cast<uint32_t>(n);
 
-    for (BigInteger i = BigConstants::TWO; i <= N; ++i) {
-        f *= i;
+    return odd_factorial(m, primes_up_to(m)) << (m - static_cast<uint32_t>(std::popcount(m)));
+}
+
+// -------- Binomial Coefficients --------
+
+// Exponent of p in n! (Legendre's formula)
+static uint64_t legendre(uint64_t n, uint64_t p)
+{
+    uint64_t e = 0;
+
+    for (n /= p; n; n /= p) {
+        e += n;
     }
-    return f;
+    return e;
+}
+
+// Product of p^exponent(p) over the primes p <= limit, where every such power is at most limit
+template <typename Exponent>
+static BigInteger prime_power_product(uint32_t limit, Exponent exponent)
+{
+    std::vector<uint64_t> factors;
+
+    for (uint32_t p : primes_up_to(limit))
+    {
+        uint64_t power = 1;
+
+        for (uint64_t e = exponent(p); e; --e) {
+            power *= p;
+        }
+        if (power > 1) {
+            factors.push_back(power);
+        }
+    }
+    return product_tree(factors);
+}
+
+// C(n, k) = n! / (k! (n - k)!) from its prime factorisation; p^e <= n by Kummer's theorem
+BigInteger BigInteger::binomial(int n, int k)
+{
+    // C(-n, k) = (-1)^k C(n + k - 1, k)
+    if (n < 0)
+    {
+        if (k < 0) {
+            return BigConstants::ZERO;
+        }
+        BigInteger c = binomial(k - n - 1, k);
+        return (k & 1) ? BigConstants::ZERO - c : c;
+    }
+    if (k < 0 || k > n) {
+        return BigConstants::ZERO;
+    }
+    const auto N = static_cast<uint64_t>(n);
+    const auto K = static_cast<uint64_t>(std::min(k, n - k));
+
+    return prime_power_product(static_cast<uint32_t>(n), [N, K](uint64_t p) {
+        return legendre(N, p) - legendre(K, p) - legendre(N - K, p);
+    });
+}
+
+// C_n = (2n)! / (n! (n + 1)!), from the factorisation of C(2n, n) less that of n + 1
+BigInteger BigInteger::catalan(int n)
+{
+    if (n < 0) {
+        throw std::invalid_argument("Arithmetic Error: catalan(n) requires n >= 0.");
+    }
+    const auto N = static_cast<uint64_t>(n);
+
+    return prime_power_product(static_cast<uint32_t>(2 * N), [N](uint64_t p) {
+        uint64_t e = legendre(2 * N, p) - 2 * legendre(N, p);
+
+        for (uint64_t m = N + 1; m % p == 0; m /= p) {
+            --e;
+        }
+        return e;
+    });
 }
 
 #undef LOG2_10
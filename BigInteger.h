@@ -11,6 +11,10 @@
 #include <algorithm>
 #include <cstdint>
 #include <cmath>
+#include <optional>
+#include <utility>
+
+#include "MappedAllocator.h"
 
 #define LOG2_10 3.32192809489
 
@@ -19,10 +23,17 @@
 
 
 class BigInteger {
+public:
+    // Decimal digits, least significant first. Large buffers may live in memory-mapped files.
+    using digit_string = std::basic_string<char, std::char_traits<char>, MappedAllocator<char>>;
+
 private:
     bool sign;
 
-    std::string digits;
+    digit_string digits;
+
+    // BigDecimal rounds and scales its mantissa digit by digit
+    friend class BigDecimal;
 
 public:
     //Constructors:
@@ -68,6 +79,16 @@ public:
     // Hexadecimal String Representation:
     std::string hex() const;
 
+    // Binary representation of |n| in base 2^32 limbs, least significant first:
+    std::vector<uint32_t> limbs() const;
+
+    static BigInteger from_limbs(const std::vector<uint32_t> &, bool negative = false);
+
+    // Binary size queries on |n|; zero has no bits and no trailing zeros:
+    std::size_t bit_length() const;
+    std::size_t count_trailing_zeros() const;
+    std::size_t popcount() const;
+
 
     /* * * * Operator Overloading * * * */
 
@@ -118,6 +139,9 @@ public:
     friend BigInteger operator * (const BigInteger &, const BigInteger &);
     friend BigInteger operator / (const BigInteger &, const BigInteger &);
 
+    // Truncating division: q = trunc(a / b), r = a - q * b takes the sign of a
+    static void divmod(const BigInteger &a, const BigInteger &b, BigInteger &q, BigInteger &r);
+
     // Modulo
     friend BigInteger &operator %= (BigInteger &, const BigInteger &);
     friend BigInteger operator % (const BigInteger &, const BigInteger &);
@@ -126,6 +150,27 @@ public:
     friend BigInteger &operator ^= (BigInteger &, const BigInteger &);
     friend BigInteger operator ^ (const BigInteger &, const BigInteger &);
 
+    // Bitwise operations, on the two's-complement form of negative numbers
+    friend BigInteger &operator <<= (BigInteger &, std::size_t);
+    friend BigInteger &operator >>= (BigInteger &, std::size_t);
+
+    friend BigInteger operator << (const BigInteger &, std::size_t);
+    friend BigInteger operator >> (const BigInteger &, std::size_t);
+
+    friend BigInteger &operator &= (BigInteger &, const BigInteger &);
+    friend BigInteger &operator |= (BigInteger &, const BigInteger &);
+
+    friend BigInteger operator & (const BigInteger &, const BigInteger &);
+    friend BigInteger operator | (const BigInteger &, const BigInteger &);
+    friend BigInteger operator ~ (const BigInteger &);
+
+    // Exclusive or; '^' is the power function
+    static BigInteger xor_bits(const BigInteger &, const BigInteger &);
+
+    bool test_bit(std::size_t) const;
+    void set_bit(std::size_t);
+    void clear_bit(std::size_t);
+
     // Read and Write
     friend std::ostream &operator << (std::ostream &, const BigInteger &);
     friend std::istream &operator >> (std::istream &, BigInteger &);
@@ -139,12 +184,79 @@ public:
     static BigInteger log10(const BigInteger &);
     static BigInteger abs(const BigInteger &);
 
+    // floor(log_b(n)) for n > 0
+    static std::size_t ilog2(const BigInteger &);
+    static std::size_t ilog10(const BigInteger &);
+    static std::size_t ilog(const BigInteger &n, const BigInteger &base);
+
+    // Roots
+    struct SqrtRem;
+
+    static BigInteger isqrt(const BigInteger &);
+    static SqrtRem isqrt_rem(const BigInteger &);
+
+    // floor(n^(1/k)); for odd k a negative n gives -iroot(-n, k)
+    static BigInteger iroot(const BigInteger &n, int k);
+
+    // Modular functions
+    static BigInteger powmod(const BigInteger &base, const BigInteger &exp, const BigInteger &mod);
+
+    // Divisibility
+    struct ExtendedGcd;
+
+    static BigInteger gcd(const BigInteger &, const BigInteger &);
+    static BigInteger lcm(const BigInteger &, const BigInteger &);
+    static ExtendedGcd gcd_ext(const BigInteger &, const BigInteger &);
+
+    // x with a * x = 1 (mod m) in [0, m), if gcd(a, m) = 1
+    static std::optional<BigInteger> modinv(const BigInteger &a, const BigInteger &m);
+
+    // Primality
+    // Trial division, Baillie-PSW, then `rounds` Miller-Rabin tests with random bases
+    static bool is_probable_prime(const BigInteger &n, int rounds = 10);
+
+    // Products, multiplied in a balanced binary tree; threads = 0 uses every hardware thread
+    static BigInteger product(const std::vector<BigInteger> &values, unsigned threads = 1);
+
+    // lo * (lo + 1) * ... * hi, or 1 if lo > hi
+    static BigInteger product_range(int64_t lo, int64_t hi, unsigned threads = 1);
+
+    // x mod m_i in [0, m_i) for every modulus, by a remainder tree over the moduli's product tree
+    static std::vector<BigInteger> remainders(const BigInteger &x, const std::vector<BigInteger> &moduli);
+
+    // The x in [0, m_0 * ... * m_{k-1}) with x = residues[i] (mod m_i), for pairwise coprime moduli
+    static BigInteger crt(const std::vector<BigInteger> &residues, const std::vector<BigInteger> &moduli);
+
     // Others
     static BigInteger catalan(int n);
+    static BigInteger binomial(int n, int k);
     static BigInteger fibonacci(int n);
+
+    // (F(n), F(n + 1))
+    static std::pair<BigInteger, BigInteger> fibonacci_pair(int n);
+
+    static BigInteger lucas(int n);
+
+    // (U_n(P, Q), V_n(P, Q)) for n >= 0, with U_0 = 0, U_1 = 1, V_0 = 2, V_1 = P
+    static std::pair<BigInteger, BigInteger> lucas_sequence(const BigInteger &P, const BigInteger &Q, int n);
     static BigInteger factorial(int n);
 };
 
+// n = root^2 + rem with 0 <= rem <= 2 * root
+struct BigInteger::SqrtRem
+{
+    BigInteger root;
+    BigInteger rem;
+};
+
+// g = gcd(a, b) = s * a + t * b
+struct BigInteger::ExtendedGcd
+{
+    BigInteger g;
+    BigInteger s;
+    BigInteger t;
+};
+
 namespace BigConstants
 {
     static const BigInteger ZERO = static_cast<int64_t>(0);
@@ -0,0 +1,397 @@
+#include "BigRational.h"
+
+
+namespace
+{
+    BigInteger negate(const BigInteger &n) {
+        return BigConstants::ZERO - n;
+    }
+
+    // Splits "[+-]p[/q]" into numerator and denominator
+    void parse(const std::string &s, BigInteger &num, BigInteger &den)
+    {
+        const std::size_t slash = s.find('/');
+
+        std::string p = s.substr(0, slash);
+        num = BigInteger(p);
+
+        if (slash == std::string::npos)
+            den = BigConstants::ONE;
+        else
+        {
+            std::string q = s.substr(slash + 1);
+            den = BigInteger(q);
+        }
+    }
+}
+
+
+/* * * * * * * * * * * Constructors * * * * * * * * * * */
+
+BigRational::BigRational(int64_t n) : num(n) {
+    reduced_digits = digits();
+}
+
+BigRational::BigRational(const BigInteger &n) : num(n)
+{
+    reduced_digits = digits();
+    reduce_if_large();
+}
+
+BigRational::BigRational(const BigInteger &p, const BigInteger &q) : num(p), den(q)
+{
+    if (Null(den)) {
+        throw std::invalid_argument("Arithmetic Error: Division By 0");
+    }
+    if (den < BigConstants::ZERO)
+    {
+        num = negate(num);
+        den = negate(den);
+    }
+    reduced = (den == BigConstants::ONE);
+    reduce_if_large();
+}
+
+BigRational::BigRational(std::string &s)
+{
+    BigInteger p, q;
+
+    parse(s, p, q);
+    *this = BigRational(p, q);
+}
+
+BigRational::BigRational(const char *s)
+{
+    BigInteger p, q;
+
+    parse(s, p, q);
+    *this = BigRational(p, q);
+}
+
+BigRational::BigRational(const BigDecimal &x)
+{
+    const int64_t e = x.get_exponent();
+
+    // The mantissa holds no factor ten, but may hold a two or a five of the denominator
+    if (e >= 0)
+        num = x.get_mantissa() * (BigConstants::TEN ^ BigInteger(e));
+    else
+    {
+        num = x.get_mantissa();
+        den = BigConstants::TEN ^ BigInteger(-e);
+        reduced = false;
+    }
+    reduce_if_large();
+}
+
+
+/* * * * * * * * * * * Reduction * * * * * * * * * * */
+
+std::size_t BigRational::digits() const {
+    return static_cast<std::size_t>(Length(num) + Length(den));
+}
+
+void BigRational::reduce() const
+{
+    if (!reduced)
+    {
+        const BigInteger g = BigInteger::gcd(num, den);
+
+        if (g != BigConstants::ONE)
+        {
+            num /= g;
+            den /= g;
+        }
+        reduced = true;
+    }
+    reduced_digits = digits();
+}
+
+void BigRational::reduce_if_large()
+{
+    // Zero has the one form 0/1, whatever sign the numerator was parsed or computed with
+    if (Null(num))
+    {
+        num = BigConstants::ZERO;
+        den = BigConstants::ONE;
+        reduced = true;
+    }
+    if (!reduced && digits() > std::max(REDUCE_MIN_DIGITS, 2 * reduced_digits)) {
+        reduce();
+    }
+}
+
+const BigInteger &BigRational::numerator() const
+{
+    reduce();
+    return num;
+}
+
+const BigInteger &BigRational::denominator() const
+{
+    reduce();
+    return den;
+}
+
+std::string BigRational::toString() const
+{
+    reduce();
+
+    if (den == BigConstants::ONE) {
+        return num.toString();
+    }
+    return num.toString() + "/" + den.toString();
+}
+
+bool Null(const BigRational &a) {
+    return Null(a.num);
+}
+
+bool BigRational::is_negative() const {
+    return num < BigConstants::ZERO;
+}
+
+bool BigRational::is_integer() const
+{
+    reduce();
+    return den == BigConstants::ONE;
+}
+
+
+/* * * * * * * * * * * Operator Overloading * * * * * * * * * * */
+
+// -------- Casts --------
+BigRational::operator BigInteger() const
+{
+    BigInteger q, r;
+
+    BigInteger::divmod(num, den, q, r);
+    return q;
+}
+
+BigRational::operator BigDecimal() const {
+    return to_decimal(*this, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+// -------- Addition and Subtraction --------
+BigRational &operator += (BigRational &a, const BigRational &b)
+{
+    // Sums over a common denominator keep it; others multiply the denominators without a gcd
+    if (a.den == b.den)
+    {
+        a.num += b.num;
+        a.reduced = (a.den == BigConstants::ONE);
+    }
+    else
+    {
+        BigInteger num = a.num * b.den + b.num * a.den;
+        BigInteger den = a.den * b.den;
+
+        a.num = std::move(num);
+        a.den = std::move(den);
+        a.reduced = false;
+    }
+    a.reduced_digits = std::max(a.reduced_digits, b.reduced_digits);
+    a.reduce_if_large();
+    return a;
+}
+
+BigRational &operator -= (BigRational &a, const BigRational &b) {
+    return a += -b;
+}
+
+BigRational operator + (const BigRational &a, const BigRational &b)
+{
+    BigRational result(a);
+    return result += b;
+}
+
+BigRational operator - (const BigRational &a, const BigRational &b)
+{
+    BigRational result(a);
+    return result -= b;
+}
+
+BigRational operator - (const BigRational &a)
+{
+    BigRational result(a);
+
+    result.num = negate(a.num);
+    return result;
+}
+
+// -------- Comparison --------
+bool operator == (const BigRational &a, const BigRational &b)
+{
+    a.reduce();
+    b.reduce();
+
+    return a.num == b.num && a.den == b.den;
+}
+
+bool operator != (const BigRational &a, const BigRational &b) {
+    return !(a == b);
+}
+
+bool operator > (const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) > 0;
+}
+
+bool operator < (const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) < 0;
+}
+
+bool operator >= (const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) >= 0;
+}
+
+bool operator <= (const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) <= 0;
+}
+
+// -------- Multiplication and Division --------
+BigRational &operator *= (BigRational &a, const BigRational &b)
+{
+    if (Null(a) || Null(b))
+    {
+        a = BigRational();
+        return a;
+    }
+    // (p / q)(r / s) = ((p / g1)(r / g2)) / ((q / g2)(s / g1)) for g1 = gcd(p, s), g2 = gcd(r, q): the
+    // factors cancelled are smaller than the product, and reduced operands give a reduced product
+    BigInteger p = a.num, q = a.den;
+    BigInteger r = b.num, s = b.den;
+
+    if (s != BigConstants::ONE)
+    {
+        const BigInteger g1 = BigInteger::gcd(p, s);
+
+        if (g1 != BigConstants::ONE)
+        {
+            p /= g1;
+            s /= g1;
+        }
+    }
+    if (q != BigConstants::ONE)
+    {
+        const BigInteger g2 = BigInteger::gcd(r, q);
+
+        if (g2 != BigConstants::ONE)
+        {
+            r /= g2;
+            q /= g2;
+        }
+    }
+    const bool both_reduced = a.reduced && b.reduced;
+    const std::size_t previous = std::max(a.reduced_digits, b.reduced_digits);
+
+    a.num = p * r;
+    a.den = q * s;
+    a.reduced = both_reduced;
+    a.reduced_digits = (both_reduced ? a.digits() : previous);
+    a.reduce_if_large();
+    return a;
+}
+
+BigRational &operator /= (BigRational &a, const BigRational &b) {
+    return a *= BigRational::reciprocal(b);
+}
+
+BigRational operator * (const BigRational &a, const BigRational &b)
+{
+    BigRational result(a);
+    return result *= b;
+}
+
+BigRational operator / (const BigRational &a, const BigRational &b)
+{
+    BigRational result(a);
+    return result /= b;
+}
+
+// -------- Power Function --------
+BigRational &operator ^= (BigRational &a, const BigInteger &e)
+{
+    a = a ^ e;
+    return a;
+}
+
+BigRational operator ^ (const BigRational &a, const BigInteger &e)
+{
+    // Powers of a reduced fraction are reduced
+    const BigRational base = (e < BigConstants::ZERO ? BigRational::reciprocal(a) : a);
+    const BigInteger n = (e < BigConstants::ZERO ? negate(e) : e);
+
+    base.reduce();
+
+    BigRational result;
+
+    result.num = base.num ^ n;
+    result.den = base.den ^ n;
+    result.reduced_digits = result.digits();
+
+    return result;
+}
+
+// -------- Read and Write --------
+std::ostream &operator << (std::ostream &os, const BigRational &a) {
+    return os << a.toString();
+}
+
+std::istream &operator >> (std::istream &is, BigRational &a)
+{
+    std::string s;
+
+    if (is >> s) {
+        a = BigRational(s);
+    }
+    return is;
+}
+
+
+/* * * * * * * * * * * Arithmetic functions * * * * * * * * * * */
+
+int BigRational::compare(const BigRational &a, const BigRational &b)
+{
+    const bool neg_a = a.is_negative();
+    const bool neg_b = b.is_negative();
+
+    if (neg_a != neg_b) {
+        return (neg_a ? -1 : 1);
+    }
+    a.reduce();
+    b.reduce();
+
+    if (a.den == b.den) {
+        return (a.num < b.num ? -1 : a.num > b.num ? 1 : 0);
+    }
+    const BigInteger left = a.num * b.den;
+    const BigInteger right = b.num * a.den;
+
+    return (left < right ? -1 : left > right ? 1 : 0);
+}
+
+BigRational BigRational::abs(const BigRational &a) {
+    return (a.is_negative() ? -a : a);
+}
+
+BigRational BigRational::reciprocal(const BigRational &a)
+{
+    if (Null(a)) {
+        throw std::invalid_argument("Arithmetic Error: Division By 0");
+    }
+    BigRational result(a);
+
+    std::swap(result.num, result.den);
+
+    if (result.den < BigConstants::ZERO)
+    {
+        result.num = negate(result.num);
+        result.den = negate(result.den);
+    }
+    return result;
+}
+
+BigDecimal BigRational::to_decimal(const BigRational &a, std::size_t digits, BigDecimal::Rounding mode) {
+    return BigDecimal::div(BigDecimal(a.num), BigDecimal(a.den), digits, mode);
+}
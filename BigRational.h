@@ -0,0 +1,134 @@
+#ifndef BIGINTEGER_BIGRATIONAL_H
+#define BIGINTEGER_BIGRATIONAL_H
+
+#include "BigDecimal.h"
+
+
+/*
+ * Exact rational number num / den with den > 0.
+ *
+ * Fractions are not kept in lowest terms after every operation: a gcd costs far more than the addition or
+ * multiplication that made it necessary. They are reduced once their size has doubled since the last
+ * reduction, and before comparisons and output; products cancel across their operands first, so that a
+ * product of reduced fractions is reduced. Reduction leaves the value alone, so const members may reduce
+ * in place, and a BigRational must not be shared between threads without synchronisation.
+ */
+class BigRational {
+public:
+    // Below this many digits in numerator and denominator together a fraction is never reduced early
+    static constexpr std::size_t REDUCE_MIN_DIGITS = 64;
+
+private:
+    mutable BigInteger num;
+    mutable BigInteger den = BigConstants::ONE;
+
+    mutable bool reduced = true;
+
+    // Digits of numerator and denominator together after the last reduction
+    mutable std::size_t reduced_digits = 0;
+
+    void reduce() const;
+
+    // Reduces once the fraction has outgrown its last reduction by the threshold
+    void reduce_if_large();
+
+    std::size_t digits() const;
+
+public:
+    // Constructors
+    BigRational(int64_t n = 0);
+
+    BigRational(const BigInteger &);
+
+    BigRational(const BigInteger &num, const BigInteger &den);
+
+    // "[+-]p[/q]"
+    BigRational(std::string &);
+
+    BigRational(const char *);
+
+    // The exact value of a decimal
+    explicit BigRational(const BigDecimal &);
+
+    BigRational(const BigRational &) = default;
+
+    BigRational(BigRational &&) noexcept = default;
+
+    ~BigRational() = default;
+
+
+    // Numerator and denominator in lowest terms
+    const BigInteger &numerator() const;
+    const BigInteger &denominator() const;
+
+    // String representation "p/q", or "p" for integers
+    std::string toString() const;
+
+    friend bool Null(const BigRational &);
+
+    bool is_negative() const;
+
+    bool is_integer() const;
+
+
+    /* * * * Operator Overloading * * * */
+
+    // Direct assignment
+    BigRational &operator = (const BigRational &) = default;
+    BigRational &operator = (BigRational &&) noexcept = default;
+
+    // Cast to Integer, truncating toward zero
+    explicit operator BigInteger() const;
+
+    // Cast to BigDecimal, correctly rounded at the calling thread's precision
+    explicit operator BigDecimal() const;
+
+    // Addition and Subtraction
+    friend BigRational &operator += (BigRational &, const BigRational &);
+    friend BigRational &operator -= (BigRational &, const BigRational &);
+
+    friend BigRational operator + (const BigRational &, const BigRational &);
+    friend BigRational operator - (const BigRational &, const BigRational &);
+
+    friend BigRational operator - (const BigRational &);
+
+    // Comparison operators
+    friend bool operator == (const BigRational &, const BigRational &);
+    friend bool operator != (const BigRational &, const BigRational &);
+
+    friend bool operator > (const BigRational &, const BigRational &);
+    friend bool operator < (const BigRational &, const BigRational &);
+
+    friend bool operator >= (const BigRational &, const BigRational &);
+    friend bool operator <= (const BigRational &, const BigRational &);
+
+    // Multiplication and Division
+    friend BigRational &operator *= (BigRational &, const BigRational &);
+    friend BigRational &operator /= (BigRational &, const BigRational &);
+
+    friend BigRational operator * (const BigRational &, const BigRational &);
+    friend BigRational operator / (const BigRational &, const BigRational &);
+
+    // Power Function, for integral exponents
+    friend BigRational &operator ^= (BigRational &, const BigInteger &);
+    friend BigRational operator ^ (const BigRational &, const BigInteger &);
+
+    // Read and Write
+    friend std::ostream &operator << (std::ostream &, const BigRational &);
+    friend std::istream &operator >> (std::istream &, BigRational &);
+
+
+    /* * * * Arithmetic functions * * * */
+
+    // -1, 0 or 1 as a <, = or > b
+    static int compare(const BigRational &a, const BigRational &b);
+
+    static BigRational abs(const BigRational &);
+    static BigRational reciprocal(const BigRational &);
+
+    // num / den correctly rounded to `digits` significant digits
+    static BigDecimal to_decimal(const BigRational &, std::size_t digits,
+                                 BigDecimal::Rounding mode = BigDecimal::Rounding::HALF_EVEN);
+};
+
+#endif //BIGINTEGER_BIGRATIONAL_H
@@ -0,0 +1,344 @@
+#include "Series.h"
+
+#include <mutex>
+#include <shared_mutex>
+
+
+namespace
+{
+    // Digits carried beyond the requested precision through the final operations
+    constexpr std::size_t CONSTANT_GUARD = 10;
+
+    int64_t terms_for(std::size_t digits, double digits_per_term) {
+        return static_cast<int64_t>(static_cast<double>(digits) / digits_per_term) + 2;
+    }
+
+
+    /* * * * * * * * * * * Series * * * * * * * * * * */
+
+    // 1/pi = 12 / 640320^(3/2) * sum (-1)^k (6k)! (13591409 + 545140134 k) / ((3k)! (k!)^3 640320^(3k))
+    constexpr int64_t CHUDNOVSKY_A = 13591409;
+    constexpr int64_t CHUDNOVSKY_B = 545140134;
+
+    // 640320^3 / 24
+    constexpr int64_t CHUDNOVSKY_C3_24 = 10939058860032000;
+
+    // Each term adds log10(640320^3 / 1728) digits
+    constexpr double CHUDNOVSKY_DIGITS_PER_TERM = 14.181647462725477;
+
+    const Series CHUDNOVSKY = {
+            [](int64_t k) { return BigInteger(k % 2 ? -(CHUDNOVSKY_A + CHUDNOVSKY_B * k) : CHUDNOVSKY_A + CHUDNOVSKY_B * k); },
+            {},
+            [](int64_t k) { return k ? BigInteger(6 * k - 5) * BigInteger(2 * k - 1) * BigInteger(6 * k - 1) : BigConstants::ONE; },
+            [](int64_t k) { return k ? BigInteger(k * k) * BigInteger(k) * BigInteger(CHUDNOVSKY_C3_24) : BigConstants::ONE; }
+    };
+
+    // e = sum 1 / k!
+    const Series EXP_ONE = {
+            [](int64_t) { return BigConstants::ONE; },
+            {},
+            [](int64_t) { return BigConstants::ONE; },
+            [](int64_t k) { return k ? BigInteger(k) : BigConstants::ONE; }
+    };
+
+    // ln 2 = 3/4 sum (-1)^k (k!)^2 / (2^k (2k + 1)!), log10(8) digits per term
+    const Series LN2 = {
+            [](int64_t) { return BigConstants::ONE; },
+            {},
+            [](int64_t k) { return k ? BigInteger(-k) : BigConstants::ONE; },
+            [](int64_t k) { return k ? BigInteger(4 * (2 * k + 1)) : BigConstants::ONE; }
+    };
+
+    constexpr double LN2_DIGITS_PER_TERM = 0.90308998699194354;
+
+    // ln 10 = 3 ln 2 + ln(5/4), with ln(5/4) = 2 atanh(1/9) = 2 sum 1 / ((2k + 1) 9^(2k + 1)), log10(81) digits per term
+    const Series ATANH_NINTH = {
+            [](int64_t) { return BigConstants::ONE; },
+            [](int64_t k) { return BigInteger(2 * k + 1); },
+            [](int64_t) { return BigConstants::ONE; },
+            [](int64_t k) { return BigInteger(k ? 81 : 9); }
+    };
+
+    constexpr double ATANH_NINTH_DIGITS_PER_TERM = 1.9084850188786497;
+
+    // zeta(3) = 1/64 sum (-1)^k (k!)^10 (205 k^2 + 250 k + 77) / ((2k + 1)!)^5 (Amdeberhan and Zeilberger),
+    // log10(1024) digits per term
+    const Series ZETA3 = {
+            [](int64_t k) { return BigInteger(205 * k * k + 250 * k + 77); },
+            {},
+            [](int64_t k) { return k ? BigConstants::ZERO - (BigInteger(k) ^ 5) : BigConstants::ONE; },
+            [](int64_t k) { return k ? BigInteger(32) * (BigInteger(2 * k + 1) ^ 5) : BigConstants::ONE; }
+    };
+
+    constexpr double ZETA3_DIGITS_PER_TERM = 3.0102999566398120;
+
+    // G = 1/64 sum_{n >= 1} (-1)^(n-1) 256^n (40n^2 - 24n + 3) ((2n)!)^3 (n!)^2 / (n^3 (2n - 1) ((4n)!)^2) (Lupas),
+    // here with k = n - 1. The term ratio carries the factor n^3 (2n - 1) of the next term's denominator, so p
+    // is shifted one term instead of keeping a separate b
+    const Series CATALAN = {
+            [](int64_t k) { return BigInteger(40 * (k + 1) * (k + 1) - 24 * (k + 1) + 3); },
+            {},
+            [](int64_t k) { return k ? BigInteger(-32 * k) * BigInteger(k * k) * BigInteger(2 * k - 1) : BigInteger(-32); },
+            [](int64_t k) { return BigInteger((4 * k + 3) * (4 * k + 3)) * BigInteger((4 * k + 1) * (4 * k + 1)); }
+    };
+
+    constexpr double CATALAN_DIGITS_PER_TERM = 0.60205999132796240;
+
+
+    /* * * * * * * * * * * Evaluation * * * * * * * * * * */
+
+    // A constant as a series, the terms it needs for `work` digits, and the step from its sum to the constant
+    struct Constant
+    {
+        const Series &series;
+
+        std::function<int64_t(std::size_t work)> terms;
+
+        std::function<BigDecimal(const BigDecimal &sum, std::size_t work)> finish;
+    };
+
+    const Constant PI_CONSTANT = {
+            CHUDNOVSKY,
+            [](std::size_t work) { return terms_for(work, CHUDNOVSKY_DIGITS_PER_TERM); },
+            // pi = 426880 sqrt(10005) / sum
+            [](const BigDecimal &sum, std::size_t work) {
+                const BigDecimal root = BigDecimal::sqrt(BigDecimal(BigInteger(10005)), work);
+
+                return BigDecimal::div(BigDecimal::mul(BigDecimal(BigInteger(426880)), root, work), sum, work);
+            }
+    };
+
+    const Constant E_CONSTANT = {
+            EXP_ONE,
+            // The first N with log10(N!) > work, and one more
+            [](std::size_t work) {
+                int64_t terms = 1;
+                double magnitude = 0;
+
+                while (magnitude <= static_cast<double>(work)) {
+                    magnitude += std::log10(static_cast<double>(++terms));
+                }
+                return terms + 1;
+            },
+            [](const BigDecimal &sum, std::size_t) { return sum; }
+    };
+
+    const Constant LN2_CONSTANT = {
+            LN2,
+            [](std::size_t work) { return terms_for(work, LN2_DIGITS_PER_TERM); },
+            [](const BigDecimal &sum, std::size_t work) { return BigDecimal::mul(sum, BigDecimal("0.75"), work); }
+    };
+
+    const Constant LN10_CONSTANT = {
+            ATANH_NINTH,
+            [](std::size_t work) { return terms_for(work, ATANH_NINTH_DIGITS_PER_TERM); },
+            [](const BigDecimal &sum, std::size_t work) {
+                const BigDecimal ln_2 = BigConstants::LN2(work);
+
+                return BigDecimal::add(BigDecimal::mul(ln_2, BigDecimal(BigInteger(3)), work),
+                                       BigDecimal::mul(sum, BigDecimal(BigConstants::TWO), work), work);
+            }
+    };
+
+    const Constant ZETA3_CONSTANT = {
+            ZETA3,
+            [](std::size_t work) { return terms_for(work, ZETA3_DIGITS_PER_TERM); },
+            [](const BigDecimal &sum, std::size_t work) { return BigDecimal::mul(sum, BigDecimal("0.015625"), work); }
+    };
+
+    // The products of p start with the sign of the first term
+    const Constant CATALAN_CONSTANT = {
+            CATALAN,
+            [](std::size_t work) { return terms_for(work, CATALAN_DIGITS_PER_TERM); },
+            [](const BigDecimal &sum, std::size_t work) { return BigDecimal::mul(sum, BigDecimal("-0.015625"), work); }
+    };
+
+    BigDecimal evaluate(const Constant &constant, std::size_t digits, unsigned threads)
+    {
+        const std::size_t work = digits + CONSTANT_GUARD;
+
+        const BigDecimal sum = constant.series.sum(constant.terms(work), work, threads);
+
+        return BigDecimal::round(constant.finish(sum, work), digits);
+    }
+
+
+    /* * * * * * * * * * * Cache * * * * * * * * * * */
+
+    /*
+     * A constant at the highest precision requested so far, shared by every thread. Lower precisions are
+     * rounded from the stored value; higher ones resume the binary splitting where the previous evaluation
+     * stopped, growing by at least half the current precision so that rising requests settle quickly.
+     */
+    class ConstantCache
+    {
+    private:
+        const Constant &constant;
+
+        std::shared_mutex mutex;
+
+        Series::Partial partial;
+
+        // The constant to `work` digits, CONSTANT_GUARD more than any precision handed out
+        BigDecimal value;
+        std::size_t work = 0;
+
+    public:
+        explicit ConstantCache(const Constant &constant) : constant(constant) {}
+
+        BigDecimal get(std::size_t digits)
+        {
+            const std::size_t need = digits + CONSTANT_GUARD;
+            {
+                std::shared_lock<std::shared_mutex> reading(mutex);
+
+                if (need <= work) {
+                    return BigDecimal::round(value, digits);
+                }
+            }
+            std::unique_lock<std::shared_mutex> writing(mutex);
+
+            // Another thread may have extended the constant in the meantime
+            if (need > work)
+            {
+                const std::size_t grown = std::max(need, work + work / 2);
+
+                constant.series.extend(partial, constant.terms(grown), 0);
+
+                value = constant.finish(constant.series.value(partial, grown), grown);
+                work = grown;
+            }
+            return BigDecimal::round(value, digits);
+        }
+    };
+
+    ConstantCache &pi_cache()
+    {
+        static ConstantCache cache(PI_CONSTANT);
+        return cache;
+    }
+
+    ConstantCache &e_cache()
+    {
+        static ConstantCache cache(E_CONSTANT);
+        return cache;
+    }
+
+    ConstantCache &ln2_cache()
+    {
+        static ConstantCache cache(LN2_CONSTANT);
+        return cache;
+    }
+
+    ConstantCache &ln10_cache()
+    {
+        static ConstantCache cache(LN10_CONSTANT);
+        return cache;
+    }
+}
+
+
+/* * * * * * * * * * * Constants * * * * * * * * * * */
+
+BigDecimal BigConstants::pi(std::size_t digits, unsigned threads)
+{
+    return evaluate(PI_CONSTANT, digits, threads);
+}
+
+BigDecimal BigConstants::e(std::size_t digits, unsigned threads)
+{
+    return evaluate(E_CONSTANT, digits, threads);
+}
+
+BigDecimal BigConstants::ln2(std::size_t digits, unsigned threads)
+{
+    return evaluate(LN2_CONSTANT, digits, threads);
+}
+
+BigDecimal BigConstants::ln10(std::size_t digits, unsigned threads)
+{
+    return evaluate(LN10_CONSTANT, digits, threads);
+}
+
+BigDecimal BigConstants::zeta3(std::size_t digits, unsigned threads)
+{
+    return evaluate(ZETA3_CONSTANT, digits, threads);
+}
+
+BigDecimal BigConstants::catalan(std::size_t digits, unsigned threads)
+{
+    return evaluate(CATALAN_CONSTANT, digits, threads);
+}
+
+BigDecimal BigConstants::PI(std::size_t digits)
+{
+    return pi_cache().get(digits);
+}
+
+BigDecimal BigConstants::PI()
+{
+    return PI(DecimalContext::current().precision);
+}
+
+BigDecimal BigConstants::E(std::size_t digits)
+{
+    return e_cache().get(digits);
+}
+
+BigDecimal BigConstants::E()
+{
+    return E(DecimalContext::current().precision);
+}
+
+BigDecimal BigConstants::LN2(std::size_t digits)
+{
+    return ln2_cache().get(digits);
+}
+
+BigDecimal BigConstants::LN2()
+{
+    return LN2(DecimalContext::current().precision);
+}
+
+BigDecimal BigConstants::LN10(std::size_t digits)
+{
+    return ln10_cache().get(digits);
+}
+
+BigDecimal BigConstants::LN10()
+{
+    return LN10(DecimalContext::current().precision);
+}
+
+/* * * * * * * * * * * Constant files * * * * * * * * * * */
+
+BigDecimal BigConstants::read_big_const(const std::string &path)
+{
+    std::ifstream file(path);
+
+    if (!file) {
+        throw std::invalid_argument("Input Error: Could not read constant file \"" + path + "\".");
+    }
+    // The expansion may be wrapped over several lines
+    std::string digits;
+    std::string line;
+
+    while (file >> line) {
+        digits += line;
+    }
+    return BigDecimal(digits);
+}
+
+void BigConstants::write_big_const(const std::string &path, const BigDecimal &value, std::size_t line_width)
+{
+    std::ofstream file(path);
+
+    const std::string digits = value.toString();
+
+    for (std::size_t i = 0; i < digits.size(); i += line_width) {
+        file << digits.substr(i, line_width) << '\n';
+    }
+    if (!file) {
+        throw std::invalid_argument("Output Error: Could not write constant file \"" + path + "\".");
+    }
+}
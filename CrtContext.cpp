@@ -0,0 +1,127 @@
+#include "CrtContext.h"
+
+
+namespace
+{
+    // x mod m in [0, m) for m > 0
+    BigInteger non_negative_mod(const BigInteger &x, const BigInteger &m)
+    {
+        BigInteger r = x % m;
+
+        if (r < BigConstants::ZERO) {
+            r += m;
+        }
+        return r;
+    }
+}
+
+
+/* * * * * * * * * * * Constructor * * * * * * * * * * */
+
+CrtContext::CrtContext(const std::vector<BigInteger> &moduli)
+{
+    if (moduli.empty()) {
+        throw std::invalid_argument("Arithmetic Error: CrtContext requires at least one modulus.");
+    }
+    for (const BigInteger &m : moduli)
+    {
+        if (m < BigConstants::ONE) {
+            throw std::invalid_argument("Arithmetic Error: CrtContext requires moduli >= 1.");
+        }
+    }
+    tree.push_back(moduli);
+
+    while (tree.back().size() > 1)
+    {
+        const std::vector<BigInteger> &level = tree.back();
+        std::vector<BigInteger> next;
+
+        next.reserve((level.size() + 1) / 2);
+
+        for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+            next.push_back(level[i] * level[i + 1]);
+        }
+        if (level.size() % 2) {
+            next.push_back(level.back());
+        }
+        tree.push_back(std::move(next));
+    }
+    // M mod m_i^2 = m_i ((M / m_i) mod m_i), so a remainder tree of M over the squared nodes
+    // yields every M / m_i mod m_i at the cost of a single descent.
+    std::vector<BigInteger> rems = { product() };
+
+    for (std::size_t j = tree.size() - 1; j-- > 0;)
+    {
+        std::vector<BigInteger> next(tree[j].size());
+
+        for (std::size_t i = 0; i < tree[j].size(); ++i) {
+            next[i] = rems[i / 2] % (tree[j][i] * tree[j][i]);
+        }
+        rems = std::move(next);
+    }
+    weights.reserve(size());
+
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        std::optional<BigInteger> w = BigInteger::modinv(rems[i] / tree[0][i], tree[0][i]);
+
+        if (!w)
+        {
+            weights.clear();
+            return;
+        }
+        weights.push_back(std::move(*w));
+    }
+}
+
+/* * * * * * * * * * * Remainder tree * * * * * * * * * * */
+
+std::vector<BigInteger> CrtContext::reduce(const BigInteger &x) const
+{
+    std::vector<BigInteger> rems = { non_negative_mod(x, product()) };
+
+    for (std::size_t j = tree.size() - 1; j-- > 0;)
+    {
+        std::vector<BigInteger> next(tree[j].size());
+
+        for (std::size_t i = 0; i < tree[j].size(); ++i) {
+            next[i] = rems[i / 2] % tree[j][i];
+        }
+        rems = std::move(next);
+    }
+    return rems;
+}
+
+/* * * * * * * * * * * Reconstruction * * * * * * * * * * */
+
+BigInteger CrtContext::reconstruct(const std::vector<BigInteger> &residues) const
+{
+    if (residues.size() != size()) {
+        throw std::invalid_argument("Arithmetic Error: reconstruct() needs one residue per modulus.");
+    }
+    if (!coprime()) {
+        throw std::invalid_argument("Arithmetic Error: CRT reconstruction requires pairwise coprime moduli.");
+    }
+    // x = sum of (r_i w_i mod m_i) * M / m_i, summed pairwise up the tree:
+    // a node's value is left * right_product + right * left_product.
+    std::vector<BigInteger> values(size());
+
+    for (std::size_t i = 0; i < size(); ++i) {
+        values[i] = non_negative_mod(non_negative_mod(residues[i], tree[0][i]) * weights[i], tree[0][i]);
+    }
+    for (std::size_t j = 0; j + 1 < tree.size(); ++j)
+    {
+        std::vector<BigInteger> next;
+
+        next.reserve(tree[j + 1].size());
+
+        for (std::size_t i = 0; i + 1 < values.size(); i += 2) {
+            next.push_back(values[i] * tree[j][i + 1] + values[i + 1] * tree[j][i]);
+        }
+        if (values.size() % 2) {
+            next.push_back(std::move(values.back()));
+        }
+        values = std::move(next);
+    }
+    return non_negative_mod(values.front(), product());
+}
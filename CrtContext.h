@@ -0,0 +1,46 @@
+#ifndef BIGINTEGER_CRTCONTEXT_H
+#define BIGINTEGER_CRTCONTEXT_H
+
+#include "BigInteger.h"
+
+#include <vector>
+
+
+/*
+ * Reduction modulo, and reconstruction from, a fixed list of moduli m_0 .. m_{k-1}.
+ *
+ * The subproduct tree of the moduli is built once. reduce() walks it top-down as a remainder tree,
+ * so all k residues cost O(M(N) log k) instead of k full-length divisions; reconstruct() walks it
+ * bottom-up to combine residues by the Chinese remainder theorem. The CRT weights are only
+ * available when the moduli are pairwise coprime.
+ */
+class CrtContext
+{
+private:
+    // tree[0] holds the moduli, tree[j + 1][i] = tree[j][2i] * tree[j][2i + 1]; the last level is M
+    std::vector<std::vector<BigInteger>> tree;
+
+    // (M / m_i)^(-1) mod m_i; empty if the moduli are not pairwise coprime
+    std::vector<BigInteger> weights;
+
+public:
+    // Requires a non-empty list of moduli >= 1
+    explicit CrtContext(const std::vector<BigInteger> &moduli);
+
+    const std::vector<BigInteger> &moduli() const { return tree.front(); }
+
+    // M = m_0 * m_1 * ... * m_{k-1}
+    const BigInteger &product() const { return tree.back().front(); }
+
+    std::size_t size() const { return tree.front().size(); }
+
+    bool coprime() const { return !weights.empty(); }
+
+    // x mod m_i in [0, m_i) for every modulus
+    std::vector<BigInteger> reduce(const BigInteger &x) const;
+
+    // The unique x in [0, M) with x = residues[i] (mod m_i); requires pairwise coprime moduli
+    BigInteger reconstruct(const std::vector<BigInteger> &residues) const;
+};
+
+#endif //BIGINTEGER_CRTCONTEXT_H
@@ -0,0 +1,777 @@
+#include "Series.h"
+
+
+namespace
+{
+    using Rounding = BigDecimal::Rounding;
+
+    // Digits beyond the requested precision at which the first evaluation is attempted
+    constexpr std::size_t ZIV_GUARD = 12;
+
+    // The internal evaluations at `wp` digits have absolute errors below 10^(EVAL_ERROR - wp)
+    constexpr int64_t EVAL_ERROR = 6;
+
+    // Digits of the reduced argument taken by the first bit-burst chunk; each further chunk doubles
+    constexpr std::size_t BURST_FIRST = 8;
+
+    // Digits of a double precision seed that a first Newton step may rely on
+    constexpr std::size_t SEED_DIGITS = 12;
+
+    // |v - value| < 10^err for the exact result v
+    struct Approx
+    {
+        BigDecimal value;
+        int64_t err;
+    };
+
+    void check_precision(std::size_t digits)
+    {
+        if (!digits) {
+            throw std::invalid_argument("Arithmetic Error: BigDecimal precision must be at least one digit.");
+        }
+    }
+
+    // The cast of BigInteger to int64_t yields the magnitude
+    int64_t signed_value(const BigInteger &n) {
+        const auto magnitude = static_cast<int64_t>(n);
+        return (n < BigConstants::ZERO ? -magnitude : magnitude);
+    }
+
+    std::size_t length(const BigInteger &m) {
+        return static_cast<std::size_t>(Length(m));
+    }
+
+    const BigDecimal &one()
+    {
+        static const BigDecimal value(BigConstants::ONE);
+        return value;
+    }
+
+    BigInteger pow10(std::size_t k)
+    {
+        std::string s(k + 1, '0');
+
+        s[0] = '1';
+        return BigInteger(s);
+    }
+
+    BigDecimal exact_add(const BigDecimal &a, const BigDecimal &b)
+    {
+        if (Null(a)) return b;
+        if (Null(b)) return a;
+
+        const int64_t top = std::max(a.adjusted(), b.adjusted()) + 1;
+        const int64_t bottom = std::min(a.get_exponent(), b.get_exponent());
+
+        return BigDecimal::add(a, b, static_cast<std::size_t>(top - bottom + 1));
+    }
+
+    BigDecimal exact_mul(const BigDecimal &a, const BigDecimal &b) {
+        return BigDecimal::mul(a, b, length(a.get_mantissa()) + length(b.get_mantissa()));
+    }
+
+    // |x| compared with one
+    int compare_one(const BigDecimal &x) {
+        return BigDecimal::compare(BigDecimal::abs(x), one());
+    }
+
+    /*
+     * Rounds the exact result from approximations f(wp) at increasing working precisions (Ziv's strategy):
+     * once the rounding of both ends of the error interval agrees, so does the rounding of the result.
+     * The results handled here are transcendental unless special-cased, so they never lie on a boundary.
+     */
+    BigDecimal correctly_rounded(std::size_t digits, Rounding mode, int64_t extra,
+                                 const std::function<Approx(std::size_t wp)> &f)
+    {
+        check_precision(digits);
+
+        std::size_t wp = digits + ZIV_GUARD + static_cast<std::size_t>(std::max<int64_t>(extra, 0));
+
+        while (true)
+        {
+            const Approx a = f(wp);
+
+            std::size_t shortfall = 0;
+
+            if (!Null(a.value))
+            {
+                const int64_t last = a.value.adjusted() - static_cast<int64_t>(digits);
+
+                if (a.err < last - 1)
+                {
+                    const BigDecimal error(BigConstants::ONE, a.err);
+
+                    const BigDecimal low = BigDecimal::round(exact_add(a.value, -error), digits, mode);
+                    const BigDecimal high = BigDecimal::round(exact_add(a.value, error), digits, mode);
+
+                    if (low == high) {
+                        return low;
+                    }
+                }
+                else
+                    shortfall = static_cast<std::size_t>(a.err - last + 2);
+            }
+            wp += std::max(wp / 2, shortfall);
+        }
+    }
+
+    // pi / 2 to `wp` digits
+    BigDecimal half_pi(std::size_t wp) {
+        return BigDecimal::mul(BigConstants::PI(wp + 2), BigDecimal("0.5"), wp + 2);
+    }
+
+
+    /* * * * * * * * * * * Bit-burst chunks * * * * * * * * * * */
+
+    // A chunk m * 10^-e of a reduced argument, with m below 10^len
+    struct Chunk
+    {
+        BigInteger m;
+        std::size_t len;
+        std::size_t e;
+    };
+
+    /*
+     * Cuts |r|, truncated to a multiple of 10^-total, into chunks for Brent's bit-burst method: the integral
+     * part and the first BURST_FIRST decimals, then runs of decimals of doubling length. Each chunk's series
+     * is summed by binary splitting; the later chunks have long numerators but are tiny, so every series
+     * needs few terms and the whole evaluation costs O(M(n) log^2 n).
+     */
+    std::vector<Chunk> burst_chunks(const BigDecimal &r, std::size_t total)
+    {
+        BigInteger units = static_cast<BigInteger>(BigDecimal::scale(r, static_cast<int64_t>(total)));
+
+        if (units < BigConstants::ZERO) {
+            units = BigConstants::ZERO - units;
+        }
+        std::string digits = units.toString();
+
+        if (digits.size() < total) {
+            digits.insert(0, total - digits.size(), '0');
+        }
+        const std::size_t integral = digits.size() - total;
+
+        std::vector<Chunk> chunks;
+
+        for (std::size_t start = 0, end = BURST_FIRST; start < total; start = end, end *= 2)
+        {
+            end = std::min(end, total);
+
+            std::string chunk = digits.substr(start ? integral + start : 0, start ? end - start : integral + end);
+            chunk.erase(0, std::min(chunk.find_first_not_of('0'), chunk.size()));
+
+            if (!chunk.empty())
+            {
+                const std::size_t len = chunk.size();
+                chunks.push_back({BigInteger(chunk), len, end});
+            }
+        }
+        return chunks;
+    }
+
+    // The number of Taylor terms v^k / k! of a chunk v < 10^(len - e) after which the tail is below 10^-(wp + 3)
+    int64_t taylor_terms(const Chunk &chunk, std::size_t wp, int64_t step)
+    {
+        const double log_v = static_cast<double>(chunk.len) - static_cast<double>(chunk.e);
+
+        int64_t terms = 1;
+
+        // From eight terms on each term is at most a third of the previous one for v < 2.4
+        while (terms < 8 || static_cast<double>(step * terms) * log_v - std::lgamma(static_cast<double>(step * terms + 1)) / std::log(10.0)
+                            >= -static_cast<double>(wp + 3)) {
+            ++terms;
+        }
+        return terms;
+    }
+
+
+    /* * * * * * * * * * * Sine and cosine * * * * * * * * * * */
+
+    // (sin v, cos v) for a chunk v < 1, summing the sine series by binary splitting
+    std::pair<BigDecimal, BigDecimal> sin_cos_chunk(const Chunk &chunk, std::size_t wp)
+    {
+        const BigInteger scale1 = pow10(chunk.e);
+        const BigInteger scale2 = scale1 * scale1;
+        const BigInteger minus_m2 = BigConstants::ZERO - chunk.m * chunk.m;
+
+        // sin v = sum (-1)^k v^(2k + 1) / (2k + 1)!
+        const Series sine = {
+                [](int64_t) { return BigConstants::ONE; },
+                {},
+                [&](int64_t k) { return k ? minus_m2 : chunk.m; },
+                [&](int64_t k) { return k ? BigInteger(2 * k * (2 * k + 1)) * scale2 : scale1; }
+        };
+        const BigDecimal s = sine.sum(taylor_terms(chunk, wp, 2), wp + 2);
+
+        // cos v > 0.5 for v < 1
+        const BigDecimal c = BigDecimal::sqrt(BigDecimal::sub(one(), BigDecimal::mul(s, s, wp + 2), wp + 2), wp + 2);
+
+        return {s, c};
+    }
+
+    // (sin r, cos r) for |r| < 1, combining the chunks by the addition theorems
+    std::pair<BigDecimal, BigDecimal> sin_cos_reduced(const BigDecimal &r, std::size_t wp)
+    {
+        BigDecimal s;
+        BigDecimal c = one();
+
+        bool first = true;
+
+        for (const Chunk &chunk : burst_chunks(r, wp + 3))
+        {
+            const auto [sj, cj] = sin_cos_chunk(chunk, wp);
+
+            if (first)
+            {
+                s = sj;
+                c = cj;
+                first = false;
+            }
+            else
+            {
+                // sin(a + b) = sin a cos b + cos a sin b, cos(a + b) = cos a cos b - sin a sin b
+                const BigDecimal next_s = BigDecimal::add(BigDecimal::mul(s, cj, wp + 2), BigDecimal::mul(c, sj, wp + 2), wp + 2);
+
+                c = BigDecimal::sub(BigDecimal::mul(c, cj, wp + 2), BigDecimal::mul(s, sj, wp + 2), wp + 2);
+                s = next_s;
+            }
+        }
+        if (r.is_negative()) {
+            s = -s;
+        }
+        return {s, c};
+    }
+
+    // (sin x, cos x) with absolute errors below 10^(EVAL_ERROR - wp)
+    std::pair<BigDecimal, BigDecimal> sin_cos(const BigDecimal &x, std::size_t wp)
+    {
+        if (BigDecimal::compare(BigDecimal::abs(x), BigDecimal("0.78")) < 0) {
+            return sin_cos_reduced(BigDecimal::round(x, wp + 5), wp);
+        }
+        // x = k pi / 2 + r with |r| <= pi / 4; the integral digits of k need as many more digits of pi
+        const auto adj = static_cast<std::size_t>(std::max<int64_t>(x.adjusted(), 0));
+
+        const BigDecimal pi_2 = BigDecimal::mul(BigConstants::PI(wp + adj + 6), BigDecimal("0.5"), wp + adj + 6);
+
+        const BigDecimal q = BigDecimal::div(x, pi_2, adj + 6);
+        const BigDecimal half(x.is_negative() ? "-0.5" : "0.5");
+
+        const auto k = static_cast<BigInteger>(BigDecimal::add(q, half, adj + 8));
+
+        const BigDecimal r = exact_add(BigDecimal::round(x, wp + adj + 6),
+                                       -BigDecimal::mul(BigDecimal(k), pi_2, wp + adj + 6));
+
+        auto [s, c] = sin_cos_reduced(r, wp);
+
+        // Rotate by the quadrant k mod 4
+        switch (static_cast<int64_t>((k % BigInteger(4) + BigInteger(4)) % BigInteger(4)))
+        {
+            case 1:
+                return {c, -s};
+            case 2:
+                return {-s, -c};
+            case 3:
+                return {-c, s};
+            default:
+                return {s, c};
+        }
+    }
+
+    // a / b from approximations with absolute errors below 10^a.err and 10^b.err
+    Approx quotient(const Approx &a, const Approx &b, std::size_t wp)
+    {
+        // b is not yet known well enough to divide by
+        if (Null(b.value) || b.err >= b.value.adjusted() - 1) {
+            return {BigDecimal(), 0};
+        }
+        const BigDecimal q = BigDecimal::div(a.value, b.value, wp + 2);
+
+        const int64_t scaled = std::max(a.err, b.err + std::max<int64_t>(q.adjusted() + 1, 0));
+
+        return {q, std::max(scaled - b.value.adjusted() + 2, q.adjusted() - static_cast<int64_t>(wp))};
+    }
+
+
+    /* * * * * * * * * * * Inverse tangent * * * * * * * * * * */
+
+    // atan x for |x| <= 1 by Newton's iteration y += cos y (x cos y - sin y) at doubling precisions
+    BigDecimal atan_unit(const BigDecimal &x, std::size_t wp)
+    {
+        if (Null(x)) {
+            return {};
+        }
+        const BigDecimal a = BigDecimal::round(x, wp + 2);
+
+        std::vector<std::size_t> steps;
+
+        for (std::size_t d = wp + 2; ; d = d / 2 + 2)
+        {
+            steps.push_back(d);
+
+            if (d <= SEED_DIGITS) break;
+        }
+        BigDecimal y(std::atan(static_cast<double>(a)));
+
+        for (std::size_t i = steps.size(); i-- > 0;)
+        {
+            const std::size_t d = steps[i];
+
+            const auto [s, c] = sin_cos(y, d);
+
+            const BigDecimal e = BigDecimal::sub(BigDecimal::mul(a, c, d + 2), s, d + 2);
+
+            y = BigDecimal::add(y, BigDecimal::mul(c, e, d + 2), d + 2);
+        }
+        return y;
+    }
+
+    // atan x for any x, through atan x = sign(x) pi / 2 - atan(1 / x) for |x| > 1
+    BigDecimal atan_any(const BigDecimal &x, std::size_t wp)
+    {
+        if (compare_one(x) <= 0) {
+            return atan_unit(x, wp);
+        }
+        const BigDecimal y = BigDecimal::sub(half_pi(wp), atan_unit(BigDecimal::reciprocal(BigDecimal::abs(x), wp + 2), wp), wp + 2);
+
+        return (x.is_negative() ? -y : y);
+    }
+
+    // sqrt(|x^2 - 1|), from the exact square
+    BigDecimal root_one_minus_square(const BigDecimal &x, std::size_t wp) {
+        return BigDecimal::sqrt(BigDecimal::abs(exact_add(exact_mul(x, x), -one())), wp + 2);
+    }
+
+    int64_t magnitude_below_one(const BigDecimal &x) {
+        return std::max<int64_t>(-x.adjusted(), 0);
+    }
+
+
+    /* * * * * * * * * * * Logarithm and exponential * * * * * * * * * * */
+
+    // Digits of n
+    int64_t digit_count(int64_t n) {
+        return static_cast<int64_t>(std::to_string(n).size());
+    }
+
+    // The arithmetic-geometric mean of a, b > 0 with a relative error of a few units in 10^-wp
+    BigDecimal agm(BigDecimal a, BigDecimal b, std::size_t wp)
+    {
+        const BigDecimal half("0.5");
+
+        while (true)
+        {
+            const BigDecimal d = BigDecimal::sub(a, b, wp + 2);
+
+            // The mean lies between a and b
+            if (Null(d) || d.adjusted() < a.adjusted() - static_cast<int64_t>(wp))
+                return a;
+
+            const BigDecimal mean = BigDecimal::mul(BigDecimal::add(a, b, wp + 3), half, wp + 2);
+
+            b = BigDecimal::sqrt(BigDecimal::mul(a, b, wp + 2), wp + 2);
+            a = mean;
+        }
+    }
+
+    /*
+     * ln x for x > 0 with an absolute error below 10^(EVAL_ERROR - wp). With x = f 10^adj, ln f comes from
+     * ln s = pi / (2 AGM(1, 4 / s)) + O(ln s / s^2) for s = f 2^m > 10^(w / 2 + 2), less m ln 2.
+     */
+    BigDecimal ln_approx(const BigDecimal &x, std::size_t wp)
+    {
+        const int64_t adj = x.adjusted();
+        const BigDecimal f = BigDecimal::round(BigDecimal::scale(x, -adj), wp + 4);
+
+        // The AGM and pi / (2 AGM) are about w in size, which costs their relative errors some digits
+        const std::size_t w = wp + 2 * static_cast<std::size_t>(digit_count(static_cast<int64_t>(wp))) + 4;
+
+        const auto m = static_cast<int64_t>(std::ceil((static_cast<double>(w) / 2 + 2) * LOG2_10));
+
+        const BigDecimal s = exact_mul(f, BigDecimal(BigConstants::TWO ^ BigInteger(m)));
+        const BigDecimal mean = agm(one(), BigDecimal::div(BigDecimal(BigInteger(4)), s, w), w);
+
+        const BigDecimal ln_s = BigDecimal::div(BigConstants::PI(w), BigDecimal::mul(mean, BigDecimal(BigConstants::TWO), w), w);
+        const BigDecimal m_ln2 = BigDecimal::mul(BigDecimal(BigInteger(m)), BigConstants::LN2(w + 2), w);
+
+        BigDecimal y = BigDecimal::sub(ln_s, m_ln2, w);
+
+        if (adj)
+        {
+            // adj ln 10 has as many more integral digits as adj
+            const std::size_t d = wp + static_cast<std::size_t>(digit_count(adj)) + 4;
+
+            y = BigDecimal::add(y, BigDecimal::mul(BigDecimal(BigInteger(adj)), BigConstants::LN10(d), d), d);
+        }
+        return y;
+    }
+
+    // e^v for a chunk v < 10 by binary splitting of sum v^k / k!
+    BigDecimal exp_chunk(const Chunk &chunk, std::size_t wp)
+    {
+        const BigInteger scale = pow10(chunk.e);
+
+        const Series taylor = {
+                [](int64_t) { return BigConstants::ONE; },
+                {},
+                [&](int64_t k) { return k ? chunk.m : BigConstants::ONE; },
+                [&](int64_t k) { return k ? BigInteger(k) * scale : BigConstants::ONE; }
+        };
+        return taylor.sum(taylor_terms(chunk, wp, 1), wp + 2);
+    }
+
+    // e^x with a relative error below 10^(EVAL_ERROR - wp), as e^r 10^k for x = k ln 10 + r with 0 <= r < ln 10
+    BigDecimal exp_approx(const BigDecimal &x, std::size_t wp)
+    {
+        // Beyond this the power of ten overflows the exponent
+        if (x.adjusted() > 17) {
+            throw std::invalid_argument("Arithmetic Error: exp(x) out of the BigDecimal exponent range.");
+        }
+        const auto adj = static_cast<std::size_t>(std::max<int64_t>(x.adjusted(), 0));
+
+        const BigDecimal ln10 = BigConstants::LN10(wp + adj + 6);
+
+        const BigDecimal q = BigDecimal::div(x, ln10, adj + 6);
+
+        // floor(q), which may be one off when q is within the error of an integer; r is corrected below
+        BigInteger k = static_cast<BigInteger>(q);
+
+        if (q.is_negative() && !q.is_integer()) {
+            k -= BigConstants::ONE;
+        }
+        BigDecimal r = exact_add(BigDecimal::round(x, wp + adj + 6), -BigDecimal::mul(BigDecimal(k), ln10, wp + adj + 6));
+
+        if (r.is_negative())
+        {
+            r = exact_add(r, ln10);
+            k -= BigConstants::ONE;
+        }
+        BigDecimal y = one();
+
+        for (const Chunk &chunk : burst_chunks(r, wp + 3))
+            y = BigDecimal::mul(y, exp_chunk(chunk, wp), wp + 2);
+
+        return BigDecimal::scale(y, signed_value(k));
+    }
+
+    // Extra digits lost to cancellation in ln x for x near one
+    int64_t closeness_to_one(const BigDecimal &x) {
+        return std::max<int64_t>(-exact_add(x, -one()).adjusted(), 0);
+    }
+
+    void check_logarithm(const BigDecimal &x, const char *name)
+    {
+        if (Null(x) || x.is_negative()) {
+            throw std::invalid_argument(std::string("Arithmetic Error: ") + name + "(x) not defined for x <= 0.");
+        }
+    }
+
+    // log_b x = ln x / ln b from the cached ln b
+    BigDecimal logarithm(const BigDecimal &x, std::size_t digits, Rounding mode,
+                         BigDecimal (*ln_base)(std::size_t))
+    {
+        return correctly_rounded(digits, mode, closeness_to_one(x), [&](std::size_t wp) {
+            const Approx ln_x{ln_approx(x, wp), EVAL_ERROR - static_cast<int64_t>(wp)};
+            const Approx ln_b{ln_base(wp + 2), -static_cast<int64_t>(wp)};
+
+            return quotient(ln_x, ln_b, wp);
+        });
+    }
+}
+
+
+/* * * * * * * * * * * Trigonometric functions * * * * * * * * * * */
+
+BigDecimal BigDecimal::sin(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    check_precision(digits);
+
+    if (Null(x)) {
+        return {};
+    }
+    // sin x is about x for small x
+    return correctly_rounded(digits, mode, magnitude_below_one(x), [&](std::size_t wp) {
+        return Approx{sin_cos(x, wp).first, EVAL_ERROR - static_cast<int64_t>(wp)};
+    });
+}
+
+BigDecimal BigDecimal::cos(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    check_precision(digits);
+
+    if (Null(x)) {
+        return round(one(), digits, mode);
+    }
+    return correctly_rounded(digits, mode, 0, [&](std::size_t wp) {
+        return Approx{sin_cos(x, wp).second, EVAL_ERROR - static_cast<int64_t>(wp)};
+    });
+}
+
+BigDecimal BigDecimal::tan(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    check_precision(digits);
+
+    if (Null(x)) {
+        return {};
+    }
+    return correctly_rounded(digits, mode, magnitude_below_one(x), [&](std::size_t wp) {
+        const auto [s, c] = sin_cos(x, wp);
+        const int64_t err = EVAL_ERROR - static_cast<int64_t>(wp);
+
+        return quotient({s, err}, {c, err}, wp);
+    });
+}
+
+BigDecimal BigDecimal::cot(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    if (Null(x)) {
+        throw std::invalid_argument("Arithmetic Error: cot(x) not defined for x = 0.");
+    }
+    check_precision(digits);
+
+    return correctly_rounded(digits, mode, 0, [&](std::size_t wp) {
+        const auto [s, c] = sin_cos(x, wp);
+        const int64_t err = EVAL_ERROR - static_cast<int64_t>(wp);
+
+        return quotient({c, err}, {s, err}, wp);
+    });
+}
+
+BigDecimal BigDecimal::asin(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    if (compare_one(x) > 0) {
+        throw std::invalid_argument("Arithmetic Error: asin(x) not defined for |x| > 1.");
+    }
+    check_precision(digits);
+
+    if (Null(x)) {
+        return {};
+    }
+    return correctly_rounded(digits, mode, magnitude_below_one(x), [&](std::size_t wp) {
+        const BigDecimal a = abs(x);
+        const BigDecimal root = root_one_minus_square(a, wp);
+
+        // asin a = atan(a / sqrt(1 - a^2)) = pi / 2 - atan(sqrt(1 - a^2) / a), whichever quotient is at most one
+        BigDecimal y;
+
+        if (compare(a, BigDecimal("0.7")) <= 0)
+            y = atan_unit(div(a, root, wp + 2), wp);
+        else if (Null(root))
+            y = half_pi(wp);
+        else
+            y = sub(half_pi(wp), atan_unit(div(root, a, wp + 2), wp), wp + 2);
+
+        return Approx{x.is_negative() ? -y : y, EVAL_ERROR + 1 - static_cast<int64_t>(wp)};
+    });
+}
+
+BigDecimal BigDecimal::acos(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    if (compare_one(x) > 0) {
+        throw std::invalid_argument("Arithmetic Error: acos(x) not defined for |x| > 1.");
+    }
+    check_precision(digits);
+
+    if (x == one()) {
+        return {};
+    }
+    return correctly_rounded(digits, mode, 0, [&](std::size_t wp) {
+        const BigDecimal a = abs(x);
+
+        // acos a = 2 atan(sqrt((1 - a) / (1 + a))) for a >= 0, and acos(-a) = pi - acos a
+        const BigDecimal t = sqrt(div(exact_add(one(), -a), exact_add(one(), a), wp + 2), wp + 2);
+
+        BigDecimal y = mul(atan_unit(t, wp), BigDecimal(BigConstants::TWO), wp + 2);
+
+        if (x.is_negative()) {
+            y = sub(BigConstants::PI(wp + 2), y, wp + 2);
+        }
+        return Approx{y, EVAL_ERROR + 1 - static_cast<int64_t>(wp)};
+    });
+}
+
+BigDecimal BigDecimal::atan(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    check_precision(digits);
+
+    if (Null(x)) {
+        return {};
+    }
+    return correctly_rounded(digits, mode, magnitude_below_one(x), [&](std::size_t wp) {
+        return Approx{atan_any(x, wp), EVAL_ERROR + 1 - static_cast<int64_t>(wp)};
+    });
+}
+
+BigDecimal BigDecimal::acot(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    check_precision(digits);
+
+    // acot x = atan(1 / x), so that acot(-x) = -acot x; acot 0 = pi / 2
+    const int64_t extra = (Null(x) ? 0 : std::max<int64_t>(x.adjusted(), 0));
+
+    return correctly_rounded(digits, mode, extra, [&](std::size_t wp) {
+        BigDecimal y;
+
+        if (Null(x))
+            y = half_pi(wp);
+        else if (compare_one(x) >= 0)
+            y = atan_unit(reciprocal(x, wp + 2), wp);
+        else
+        {
+            y = sub(half_pi(wp), atan_unit(abs(x), wp), wp + 2);
+
+            if (x.is_negative()) {
+                y = -y;
+            }
+        }
+        return Approx{y, EVAL_ERROR + 1 - static_cast<int64_t>(wp)};
+    });
+}
+
+BigDecimal BigDecimal::asec(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    if (compare_one(x) < 0) {
+        throw std::invalid_argument("Arithmetic Error: asec(x) not defined for |x| < 1.");
+    }
+    check_precision(digits);
+
+    if (x == one()) {
+        return {};
+    }
+    return correctly_rounded(digits, mode, 0, [&](std::size_t wp) {
+        // asec x = atan(sqrt(x^2 - 1)) for x >= 1, and pi minus that for x <= -1
+        BigDecimal y = atan_any(root_one_minus_square(x, wp), wp);
+
+        if (x.is_negative()) {
+            y = sub(BigConstants::PI(wp + 2), y, wp + 2);
+        }
+        return Approx{y, EVAL_ERROR + 2 - static_cast<int64_t>(wp)};
+    });
+}
+
+BigDecimal BigDecimal::acsc(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    if (compare_one(x) < 0) {
+        throw std::invalid_argument("Arithmetic Error: acsc(x) not defined for |x| < 1.");
+    }
+    check_precision(digits);
+
+    return correctly_rounded(digits, mode, std::max<int64_t>(x.adjusted(), 0), [&](std::size_t wp) {
+        const BigDecimal root = root_one_minus_square(x, wp);
+
+        // acsc x = asin(1 / x) = sign(x) atan(1 / sqrt(x^2 - 1))
+        const BigDecimal y = (Null(root) ? half_pi(wp) : atan_any(reciprocal(root, wp + 2), wp));
+
+        return Approx{x.is_negative() ? -y : y, EVAL_ERROR + 2 - static_cast<int64_t>(wp)};
+    });
+}
+
+/* * * * * * * * * * * Logarithm and exponential * * * * * * * * * * */
+
+BigDecimal BigDecimal::ln(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    check_logarithm(x, "ln");
+    check_precision(digits);
+
+    if (x == one()) {
+        return {};
+    }
+    return correctly_rounded(digits, mode, closeness_to_one(x), [&](std::size_t wp) {
+        return Approx{ln_approx(x, wp), EVAL_ERROR - static_cast<int64_t>(wp)};
+    });
+}
+
+BigDecimal BigDecimal::exp(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    check_precision(digits);
+
+    if (Null(x)) {
+        return round(one(), digits, mode);
+    }
+    return correctly_rounded(digits, mode, 0, [&](std::size_t wp) {
+        const BigDecimal y = exp_approx(x, wp);
+
+        return Approx{y, y.adjusted() + 1 + EVAL_ERROR - static_cast<int64_t>(wp)};
+    });
+}
+
+BigDecimal BigDecimal::log2(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    check_logarithm(x, "log2");
+    check_precision(digits);
+
+    // Powers of two are 2^k or 5^k * 10^-k, and have exact logarithms
+    if (x.exponent == 0 && x.mantissa.popcount() == 1) {
+        return round(BigDecimal(BigInteger(static_cast<int64_t>(x.mantissa.bit_length()) - 1)), digits, mode);
+    }
+    if (x.exponent < 0 && x.mantissa == (BigConstants::FIVE ^ BigInteger(-x.exponent))) {
+        return round(BigDecimal(BigInteger(x.exponent)), digits, mode);
+    }
+    return logarithm(x, digits, mode, BigConstants::LN2);
+}
+
+BigDecimal BigDecimal::log10(const BigDecimal &x, std::size_t digits, Rounding mode)
+{
+    check_logarithm(x, "log10");
+    check_precision(digits);
+
+    if (x.mantissa == BigConstants::ONE) {
+        return round(BigDecimal(BigInteger(x.exponent)), digits, mode);
+    }
+    return logarithm(x, digits, mode, BigConstants::LN10);
+}
+
+BigDecimal BigDecimal::ln(const BigDecimal &x) {
+    return ln(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::exp(const BigDecimal &x) {
+    return exp(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::log2(const BigDecimal &x) {
+    return log2(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::log10(const BigDecimal &x) {
+    return log10(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::sin(const BigDecimal &x) {
+    return sin(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::cos(const BigDecimal &x) {
+    return cos(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::tan(const BigDecimal &x) {
+    return tan(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::cot(const BigDecimal &x) {
+    return cot(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::asin(const BigDecimal &x) {
+    return asin(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::acos(const BigDecimal &x) {
+    return acos(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::atan(const BigDecimal &x) {
+    return atan(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::acot(const BigDecimal &x) {
+    return acot(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::asec(const BigDecimal &x) {
+    return asec(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
+
+BigDecimal BigDecimal::acsc(const BigDecimal &x) {
+    return acsc(x, DecimalContext::current().precision, DecimalContext::current().rounding);
+}
@@ -0,0 +1,692 @@
+#ifndef BIGINTEGER_KERNELS_H
+#define BIGINTEGER_KERNELS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+/*
+ * Multiplication and division kernels shared by the two word radices of the library: the base 2^32 limbs
+ * of Limbs, behind gcd, powmod and the other number-theoretic functions, and the base 10^9 words that
+ * BigInteger packs its decimal digits into for products and quotients. Both radices are needed because
+ * BigInteger stores decimal digits: packing them nine to a word is linear, while converting to binary and
+ * back costs about as much as the product it would serve. The algorithms below are written once for any
+ * base below 2^33; only the cut-over sizes differ, and all of them are set in Tuning.
+ *
+ * A word vector holds an unsigned integer least significant word first, without leading zero words.
+ */
+namespace Kernels
+{
+    // Cut-over sizes, in words, for one base
+    template <uint64_t BASE>
+    struct Tuning;
+
+    template <>
+    struct Tuning<static_cast<uint64_t>(1) << 32>
+    {
+        // Below this many words the quadratic kernels are faster than Karatsuba
+        static constexpr std::size_t KARATSUBA = 32;
+
+        // Operands of at least this many words are multiplied by the number-theoretic transform
+        static constexpr std::size_t NTT = 1024;
+
+        // Longest product the transform handles: terms below (n / 2) (2^32)^2 stay under P1 P2 P3 ~ 2^86
+        static constexpr std::size_t NTT_MAX_LENGTH = static_cast<std::size_t>(1) << 22;
+
+        // Divisors of at least this many words are divided through a Newton reciprocal; shifts make
+        // the schoolbook division cheap in this base, so the cut-over is late
+        static constexpr std::size_t NEWTON_DIVISION = 4096;
+    };
+
+    template <>
+    struct Tuning<1000000000>
+    {
+        static constexpr std::size_t KARATSUBA = 24;
+        static constexpr std::size_t NTT = 768;
+
+        // The longest transform all three primes support
+        static constexpr std::size_t NTT_MAX_LENGTH = static_cast<std::size_t>(1) << 23;
+
+        static constexpr std::size_t NEWTON_DIVISION = 1024;
+    };
+
+
+    // Number-theoretic transform modulo a prime P = c * 2^k + 1 with primitive root G
+    template <typename Vec, uint32_t P, uint32_t G>
+    struct Ntt
+    {
+        static uint32_t pow(uint64_t a, uint64_t e)
+        {
+            uint64_t r = 1;
+
+            for (a %= P; e; e >>= 1, a = a * a % P)
+            {
+                if (e & 1) r = r * a % P;
+            }
+            return static_cast<uint32_t>(r);
+        }
+
+        // In-place iterative transform of a power-of-two length
+        static void transform(Vec &a, bool inverse)
+        {
+            const std::size_t n = a.size();
+
+            for (std::size_t i = 1, j = 0; i < n; ++i)
+            {
+                std::size_t bit = n >> 1;
+
+                for (; j & bit; bit >>= 1) {
+                    j ^= bit;
+                }
+                j ^= bit;
+
+                if (i < j) std::swap(a[i], a[j]);
+            }
+            Vec roots(n / 2);
+
+            for (std::size_t len = 2; len <= n; len <<= 1)
+            {
+                uint64_t w = pow(G, (P - 1) / len);
+
+                if (inverse) {
+                    w = pow(w, P - 2);
+                }
+                const std::size_t half = len / 2;
+
+                roots[0] = 1;
+
+                for (std::size_t j = 1; j < half; ++j) {
+                    roots[j] = static_cast<uint32_t>(roots[j - 1] * w % P);
+                }
+                for (std::size_t i = 0; i < n; i += len)
+                {
+                    for (std::size_t j = 0; j < half; ++j)
+                    {
+                        uint32_t u = a[i + j];
+                        auto v = static_cast<uint32_t>(static_cast<uint64_t>(a[i + j + half]) * roots[j] % P);
+
+                        a[i + j] = u + v >= P ? u + v - P : u + v;
+                        a[i + j + half] = u >= v ? u - v : u + P - v;
+                    }
+                }
+            }
+            if (inverse)
+            {
+                uint64_t n_inv = pow(n, P - 2);
+
+                for (uint32_t &x : a) {
+                    x = static_cast<uint32_t>(x * n_inv % P);
+                }
+            }
+        }
+
+        // Cyclic convolution of length n modulo P; b == nullptr squares a
+        static Vec convolve(const Vec &a, const Vec *b, std::size_t n)
+        {
+            Vec fa(n, 0);
+
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                fa[i] = a[i] % P;
+            }
+            transform(fa, false);
+
+            if (b)
+            {
+                Vec fb(n, 0);
+
+                for (std::size_t i = 0; i < b->size(); ++i) {
+                    fb[i] = (*b)[i] % P;
+                }
+                transform(fb, false);
+
+                for (std::size_t i = 0; i < n; ++i) {
+                    fa[i] = static_cast<uint32_t>(static_cast<uint64_t>(fa[i]) * fb[i] % P);
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < n; ++i) {
+                    fa[i] = static_cast<uint32_t>(static_cast<uint64_t>(fa[i]) * fa[i] % P);
+                }
+            }
+            transform(fa, true);
+            return fa;
+        }
+    };
+
+
+    // Arithmetic on vectors of 32-bit words in base BASE
+    template <typename Vec, uint64_t BASE>
+    struct Radix
+    {
+        using Tune = Tuning<BASE>;
+
+        static void trim(Vec &a)
+        {
+            while (!a.empty() && !a.back()) {
+                a.pop_back();
+            }
+        }
+
+        static int compare(const Vec &a, const Vec &b)
+        {
+            if (a.size() != b.size()) {
+                return a.size() < b.size() ? -1 : 1;
+            }
+            for (std::size_t i = a.size(); i-- > 0;)
+            {
+                if (a[i] != b[i])
+                    return a[i] < b[i] ? -1 : 1;
+            }
+            return 0;
+        }
+
+        static Vec slice(const Vec &a, std::size_t lo, std::size_t hi)
+        {
+            lo = std::min(lo, a.size());
+            hi = std::min(hi, a.size());
+
+            Vec r(a.begin() + static_cast<std::ptrdiff_t>(lo), a.begin() + static_cast<std::ptrdiff_t>(hi));
+
+            trim(r);
+            return r;
+        }
+
+        // a * BASE^k
+        static Vec shift_up(const Vec &a, std::size_t k)
+        {
+            if (a.empty()) {
+                return {};
+            }
+            Vec r(k, 0);
+
+            r.insert(r.end(), a.begin(), a.end());
+            return r;
+        }
+
+        // BASE^k
+        static Vec base_power(std::size_t k)
+        {
+            Vec r(k + 1, 0);
+
+            r[k] = 1;
+            return r;
+        }
+
+        static Vec add(const Vec &a, const Vec &b)
+        {
+            const Vec &x = a.size() >= b.size() ? a : b;
+            const Vec &y = a.size() >= b.size() ? b : a;
+
+            Vec r(x.size() + 1);
+            uint64_t carry = 0;
+
+            for (std::size_t i = 0; i < x.size(); ++i)
+            {
+                uint64_t t = static_cast<uint64_t>(x[i]) + (i < y.size() ? y[i] : 0) + carry;
+
+                carry = t >= BASE;
+                r[i] = static_cast<uint32_t>(carry ? t - BASE : t);
+            }
+            r[x.size()] = static_cast<uint32_t>(carry);
+
+            trim(r);
+            return r;
+        }
+
+        // a -= b, requires a >= b
+        static void sub_in_place(Vec &a, const Vec &b)
+        {
+            uint64_t borrow = 0;
+
+            for (std::size_t i = 0; i < a.size() && (i < b.size() || borrow); ++i)
+            {
+                uint64_t t = (i < b.size() ? b[i] : 0) + borrow;
+
+                borrow = a[i] < t;
+                a[i] = static_cast<uint32_t>(borrow ? a[i] + BASE - t : a[i] - t);
+            }
+            trim(a);
+        }
+
+        // r += x * BASE^shift, r large enough to hold the result
+        static void add_shifted(Vec &r, const Vec &x, std::size_t shift)
+        {
+            uint64_t carry = 0;
+            std::size_t i = 0;
+
+            for (; i < x.size(); ++i)
+            {
+                uint64_t t = static_cast<uint64_t>(r[i + shift]) + x[i] + carry;
+
+                carry = t >= BASE;
+                r[i + shift] = static_cast<uint32_t>(carry ? t - BASE : t);
+            }
+            for (i += shift; carry; ++i)
+            {
+                uint64_t t = r[i] + carry;
+
+                carry = t >= BASE;
+                r[i] = static_cast<uint32_t>(carry ? t - BASE : t);
+            }
+        }
+
+        static Vec mul_basecase(const Vec &a, const Vec &b)
+        {
+            Vec r(a.size() + b.size(), 0);
+
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                const uint64_t ai = a[i];
+                uint64_t carry = 0;
+
+                if (!ai) continue;
+
+                for (std::size_t j = 0; j < b.size(); ++j)
+                {
+                    carry += ai * b[j] + r[i + j];
+                    r[i + j] = static_cast<uint32_t>(carry % BASE);
+                    carry /= BASE;
+                }
+                r[i + b.size()] = static_cast<uint32_t>(carry);
+            }
+            trim(r);
+            return r;
+        }
+
+        static Vec sqr_basecase(const Vec &a)
+        {
+            const std::size_t n = a.size();
+
+            Vec r(2 * n, 0);
+
+            // Cross products a[i] * a[j] for i < j, each computed once
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const uint64_t ai = a[i];
+                uint64_t carry = 0;
+
+                for (std::size_t j = i + 1; j < n; ++j)
+                {
+                    carry += ai * a[j] + r[i + j];
+                    r[i + j] = static_cast<uint32_t>(carry % BASE);
+                    carry /= BASE;
+                }
+                r[i + n] = static_cast<uint32_t>(carry);
+            }
+            // Double them and add the squares on the diagonal
+            uint64_t carry = 0;
+
+            for (std::size_t i = 0; i < 2 * n; ++i)
+            {
+                carry += 2 * static_cast<uint64_t>(r[i]);
+                r[i] = static_cast<uint32_t>(carry % BASE);
+                carry /= BASE;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const uint64_t sq = static_cast<uint64_t>(a[i]) * a[i];
+
+                carry += r[2 * i] + sq % BASE;
+                r[2 * i] = static_cast<uint32_t>(carry % BASE);
+                carry /= BASE;
+
+                carry += r[2 * i + 1] + sq / BASE;
+                r[2 * i + 1] = static_cast<uint32_t>(carry % BASE);
+                carry /= BASE;
+            }
+            trim(r);
+            return r;
+        }
+
+        // a * b by transforms modulo three primes and Garner's reconstruction; b == nullptr squares a
+        static Vec ntt_mul(const Vec &a, const Vec *b)
+        {
+            constexpr uint64_t P1 = 998244353u, P2 = 167772161u, P3 = 469762049u;
+
+            using Ntt1 = Ntt<Vec, P1, 3>;
+            using Ntt2 = Ntt<Vec, P2, 3>;
+            using Ntt3 = Ntt<Vec, P3, 3>;
+
+            const std::size_t size = a.size() + (b ? b->size() : a.size());
+
+            std::size_t n = 1;
+
+            while (n < size) {
+                n <<= 1;
+            }
+            Vec r1 = Ntt1::convolve(a, b, n);
+            Vec r2 = Ntt2::convolve(a, b, n);
+            Vec r3 = Ntt3::convolve(a, b, n);
+
+            const uint64_t p1_inv_p2 = Ntt2::pow(P1, P2 - 2);
+            const uint64_t p12_inv_p3 = Ntt3::pow(P1 * P2 % P3, P3 - 2);
+
+            // Each term x = x1 + P1 * (x2 + P2 * x3) spreads over three words
+            std::vector<uint64_t> acc(size + 3, 0);
+
+            for (std::size_t k = 0; k + 1 < size; ++k)
+            {
+                uint64_t x1 = r1[k];
+                uint64_t x2 = (r2[k] + P2 - x1 % P2) % P2 * p1_inv_p2 % P2;
+                uint64_t x3 = (r3[k] + P3 - (x1 + P1 * x2) % P3) % P3 * p12_inv_p3 % P3;
+
+                uint64_t t = x2 + P2 * x3;
+                uint64_t low = x1 + P1 * (t % BASE);
+                uint64_t high = low / BASE + P1 * (t / BASE);
+
+                acc[k] += low % BASE;
+                acc[k + 1] += high % BASE;
+                acc[k + 2] += high / BASE;
+            }
+            Vec r(size + 3);
+            uint64_t carry = 0;
+
+            for (std::size_t k = 0; k < r.size(); ++k)
+            {
+                carry += acc[k];
+                r[k] = static_cast<uint32_t>(carry % BASE);
+                carry /= BASE;
+            }
+            trim(r);
+            return r;
+        }
+
+        static Vec mul(const Vec &a, const Vec &b)
+        {
+            if (a.empty() || b.empty()) {
+                return {};
+            }
+            if (&a == &b) {
+                return sqr(a);
+            }
+            const Vec &x = a.size() >= b.size() ? a : b;
+            const Vec &y = a.size() >= b.size() ? b : a;
+
+            if (y.size() < Tune::KARATSUBA) {
+                return mul_basecase(x, y);
+            }
+            if (y.size() >= Tune::NTT && x.size() + y.size() <= Tune::NTT_MAX_LENGTH) {
+                return ntt_mul(x, &y);
+            }
+            Vec r(x.size() + y.size() + 1, 0);
+
+            // Unbalanced operands: multiply y by x in pieces of y's length
+            if (x.size() >= 2 * y.size())
+            {
+                for (std::size_t lo = 0; lo < x.size(); lo += y.size()) {
+                    add_shifted(r, mul(slice(x, lo, lo + y.size()), y), lo);
+                }
+                trim(r);
+                return r;
+            }
+            // Karatsuba: x*y = z2 B^2h + ((x0 + x1)(y0 + y1) - z0 - z2) B^h + z0
+            const std::size_t h = x.size() / 2;
+
+            Vec x0 = slice(x, 0, h), x1 = slice(x, h, x.size());
+            Vec y0 = slice(y, 0, h), y1 = slice(y, h, y.size());
+
+            Vec z0 = mul(x0, y0);
+            Vec z2 = mul(x1, y1);
+            Vec z1 = mul(add(x0, x1), add(y0, y1));
+
+            sub_in_place(z1, z0);
+            sub_in_place(z1, z2);
+
+            add_shifted(r, z0, 0);
+            add_shifted(r, z1, h);
+            add_shifted(r, z2, 2 * h);
+
+            trim(r);
+            return r;
+        }
+
+        static Vec sqr(const Vec &a)
+        {
+            if (a.empty()) {
+                return {};
+            }
+            if (a.size() < Tune::KARATSUBA) {
+                return sqr_basecase(a);
+            }
+            if (a.size() >= Tune::NTT && 2 * a.size() <= Tune::NTT_MAX_LENGTH) {
+                return ntt_mul(a, nullptr);
+            }
+            const std::size_t h = a.size() / 2;
+
+            Vec a0 = slice(a, 0, h), a1 = slice(a, h, a.size());
+
+            Vec z0 = sqr(a0);
+            Vec z2 = sqr(a1);
+            Vec z1 = sqr(add(a0, a1));
+
+            sub_in_place(z1, z0);
+            sub_in_place(z1, z2);
+
+            Vec r(2 * a.size() + 1, 0);
+
+            add_shifted(r, z0, 0);
+            add_shifted(r, z1, h);
+            add_shifted(r, z2, 2 * h);
+
+            trim(r);
+            return r;
+        }
+
+        static Vec mul_small(const Vec &a, uint32_t m)
+        {
+            Vec r(a.size() + 1);
+            uint64_t carry = 0;
+
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                carry += static_cast<uint64_t>(a[i]) * m;
+                r[i] = static_cast<uint32_t>(carry % BASE);
+                carry /= BASE;
+            }
+            r[a.size()] = static_cast<uint32_t>(carry);
+
+            trim(r);
+            return r;
+        }
+
+        // a /= d in place, returning the remainder
+        static uint32_t div_small(Vec &a, uint32_t d)
+        {
+            uint64_t rem = 0;
+
+            for (std::size_t i = a.size(); i-- > 0;)
+            {
+                rem = rem * BASE + a[i];
+                a[i] = static_cast<uint32_t>(rem / d);
+                rem %= d;
+            }
+            trim(a);
+            return static_cast<uint32_t>(rem);
+        }
+
+        // Knuth's Algorithm D; requires a >= b > 0
+        static void divmod_basecase(const Vec &a, const Vec &b, Vec &q, Vec &r)
+        {
+            const std::size_t n = b.size();
+            const std::size_t m = a.size() - n;
+
+            if (n == 1)
+            {
+                q = a;
+                r = Vec{ div_small(q, b[0]) };
+                trim(r);
+                return;
+            }
+            // Normalise so that the top divisor word is at least BASE / 2
+            const auto d = static_cast<uint32_t>(BASE / (static_cast<uint64_t>(b.back()) + 1));
+
+            Vec u = mul_small(a, d);
+            Vec v = mul_small(b, d);
+
+            u.resize(a.size() + 1, 0);
+
+            q.assign(m + 1, 0);
+
+            for (std::size_t j = m + 1; j-- > 0;)
+            {
+                uint64_t num = static_cast<uint64_t>(u[j + n]) * BASE + u[j + n - 1];
+                uint64_t qhat = num / v[n - 1];
+                uint64_t rhat = num % v[n - 1];
+
+                while (qhat >= BASE || qhat * v[n - 2] > rhat * BASE + u[j + n - 2])
+                {
+                    --qhat;
+                    rhat += v[n - 1];
+
+                    if (rhat >= BASE) break;
+                }
+                // u[j .. j + n] -= qhat * v
+                uint64_t carry = 0;
+                int64_t borrow = 0;
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    uint64_t p = qhat * v[i] + carry;
+
+                    carry = p / BASE;
+
+                    int64_t t = static_cast<int64_t>(u[i + j]) - static_cast<int64_t>(p % BASE) - borrow;
+
+                    borrow = t < 0;
+                    u[i + j] = static_cast<uint32_t>(t < 0 ? t + static_cast<int64_t>(BASE) : t);
+                }
+                int64_t top = static_cast<int64_t>(u[j + n]) - static_cast<int64_t>(carry) - borrow;
+
+                // qhat was one too large: add v back
+                if (top < 0)
+                {
+                    --qhat;
+                    carry = 0;
+
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        uint64_t t = static_cast<uint64_t>(u[i + j]) + v[i] + carry;
+
+                        u[i + j] = static_cast<uint32_t>(t % BASE);
+                        carry = t / BASE;
+                    }
+                    top += static_cast<int64_t>(carry);
+                }
+                u[j + n] = static_cast<uint32_t>(top);
+                q[j] = static_cast<uint32_t>(qhat);
+            }
+            trim(q);
+
+            u.resize(n);
+            trim(u);
+            div_small(u, d);
+
+            r = std::move(u);
+        }
+
+        // floor(BASE^(2n) / b) for a divisor of n words, by Newton's iteration x += x (BASE^2n - b x) / BASE^2n
+        static Vec reciprocal(const Vec &b)
+        {
+            const std::size_t n = b.size();
+
+            if (n < Tune::NEWTON_DIVISION)
+            {
+                Vec q, r;
+
+                divmod_basecase(base_power(2 * n), b, q, r);
+                return q;
+            }
+            // The reciprocal of the top h words, scaled, is correct to about h - 1 words; one Newton
+            // step doubles that, so 2h >= n + 3 leaves only a few units to correct.
+            const std::size_t h = n / 2 + 2;
+
+            Vec x = shift_up(reciprocal(slice(b, n - h, n)), n - h);
+
+            const Vec power = base_power(2 * n);
+
+            Vec bx = mul(b, x);
+
+            if (compare(bx, power) <= 0)
+            {
+                Vec e = power;
+
+                sub_in_place(e, bx);
+                x = add(x, slice(mul(x, e), 2 * n, SIZE_MAX));
+            }
+            else
+            {
+                Vec e = bx;
+
+                sub_in_place(e, power);
+                sub_in_place(x, add(slice(mul(x, e), 2 * n, SIZE_MAX), Vec{ 1 }));
+            }
+            // A few units off at most: settle 0 <= BASE^2n - b x < b
+            bx = mul(b, x);
+
+            while (compare(bx, power) > 0)
+            {
+                sub_in_place(x, Vec{ 1 });
+                sub_in_place(bx, b);
+            }
+            Vec rem = power;
+
+            sub_in_place(rem, bx);
+
+            while (compare(rem, b) >= 0)
+            {
+                x = add(x, Vec{ 1 });
+                sub_in_place(rem, b);
+            }
+            return x;
+        }
+
+        // q = floor(a / b), r = a - q b for b > 0
+        static void divmod(const Vec &a, const Vec &b, Vec &q, Vec &r)
+        {
+            if (compare(a, b) < 0)
+            {
+                q.clear();
+                r = a;
+                return;
+            }
+            const std::size_t n = b.size();
+
+            if (n < Tune::NEWTON_DIVISION || a.size() - n < Tune::NEWTON_DIVISION)
+            {
+                divmod_basecase(a, b, q, r);
+                return;
+            }
+            const Vec mu = reciprocal(b);
+
+            // Long division in base BASE^n; each block quotient comes from Barrett's estimate
+            // floor(floor(x / BASE^(n-1)) mu / BASE^(n+1)), which is at most two below the true one.
+            const std::size_t blocks = (a.size() + n - 1) / n;
+
+            q.assign(blocks * n, 0);
+            r.clear();
+
+            for (std::size_t i = blocks; i-- > 0;)
+            {
+                Vec x = add(shift_up(r, n), slice(a, i * n, (i + 1) * n));
+                Vec qe = slice(mul(slice(x, n - 1, SIZE_MAX), mu), n + 1, SIZE_MAX);
+
+                r = x;
+                sub_in_place(r, mul(qe, b));
+
+                while (compare(r, b) >= 0)
+                {
+                    sub_in_place(r, b);
+                    qe = add(qe, Vec{ 1 });
+                }
+                std::copy(qe.begin(), qe.end(), q.begin() + static_cast<std::ptrdiff_t>(i * n));
+            }
+            trim(q);
+        }
+    };
+}
+
+#endif //BIGINTEGER_KERNELS_H
@@ -0,0 +1,1006 @@
+#include "Limbs.h"
+#include "Kernels.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <bit>
+#include <cmath>
+
+
+namespace Limbs
+{
+    /* * * * * * * * * * * Basic operations * * * * * * * * * * */
+
+    namespace
+    {
+        using Binary = Kernels::Radix<Natural, static_cast<uint64_t>(1) << LIMB_BITS>;
+    }
+
+    void trim(Natural &a) {
+        Binary::trim(a);
+    }
+
+    Natural from_uint64(uint64_t x)
+    {
+        Natural a;
+
+        while (x)
+        {
+            a.push_back(static_cast<limb_t>(x));
+            x >>= LIMB_BITS;
+        }
+        return a;
+    }
+
+    int compare(const Natural &a, const Natural &b) {
+        return Binary::compare(a, b);
+    }
+
+    Natural add(const Natural &a, const Natural &b) {
+        return Binary::add(a, b);
+    }
+
+    Natural sub(const Natural &a, const Natural &b)
+    {
+        Natural r(a);
+
+        Binary::sub_in_place(r, b);
+        return r;
+    }
+
+    Natural mul(const Natural &a, const Natural &b) {
+        return Binary::mul(a, b);
+    }
+
+    Natural sqr(const Natural &a) {
+        return Binary::sqr(a);
+    }
+
+    Natural mul_small(const Natural &a, limb_t b) {
+        return Binary::mul_small(a, b);
+    }
+
+    void divmod(const Natural &a, const Natural &b, Natural &q, Natural &r)
+    {
+        if (b.empty()) {
+            throw std::invalid_argument("Arithmetic Error: Division By 0");
+        }
+        Binary::divmod(a, b, q, r);
+    }
+
+    Natural mod(const Natural &a, const Natural &b)
+    {
+        Natural q, r;
+
+        divmod(a, b, q, r);
+
+        return r;
+    }
+
+    limb_t mod_small(const Natural &a, limb_t b)
+    {
+        if (!b) {
+            throw std::invalid_argument("Arithmetic Error: Division By 0");
+        }
+        dlimb_t rem = 0;
+
+        for (std::size_t i = a.size(); i-- > 0;) {
+            rem = ((rem << LIMB_BITS) | a[i]) % b;
+        }
+        return static_cast<limb_t>(rem);
+    }
+
+    Natural shl(const Natural &a, std::size_t bits)
+    {
+        if (a.empty()) {
+            return {};
+        }
+        const std::size_t limbs = bits / LIMB_BITS;
+        const int rest = static_cast<int>(bits % LIMB_BITS);
+
+        Natural r(a.size() + limbs + 1, 0);
+
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            r[i + limbs] |= a[i] << rest;
+
+            if (rest) {
+                r[i + limbs + 1] = a[i] >> (LIMB_BITS - rest);
+            }
+        }
+        trim(r);
+        return r;
+    }
+
+    Natural shr(const Natural &a, std::size_t bits)
+    {
+        const std::size_t limbs = bits / LIMB_BITS;
+        const int rest = static_cast<int>(bits % LIMB_BITS);
+
+        if (limbs >= a.size()) {
+            return {};
+        }
+        Natural r(a.size() - limbs);
+
+        for (std::size_t i = 0; i < r.size(); ++i)
+        {
+            r[i] = a[i + limbs] >> rest;
+
+            if (rest && i + limbs + 1 < a.size()) {
+                r[i] |= a[i + limbs + 1] << (LIMB_BITS - rest);
+            }
+        }
+        trim(r);
+        return r;
+    }
+
+    std::size_t bit_length(const Natural &a)
+    {
+        if (a.empty()) {
+            return 0;
+        }
+        return (a.size() - 1) * LIMB_BITS + static_cast<std::size_t>(std::bit_width(a.back()));
+    }
+
+    bool test_bit(const Natural &a, std::size_t bit)
+    {
+        std::size_t limb = bit / LIMB_BITS;
+
+        if (limb >= a.size()) {
+            return false;
+        }
+        return (a[limb] >> (bit % LIMB_BITS)) & 1;
+    }
+
+    /* * * * * * * * * * * Roots * * * * * * * * * * */
+
+    namespace
+    {
+        // Requires a < 2^64
+        uint64_t to_uint64(const Natural &a)
+        {
+            uint64_t x = 0;
+
+            for (std::size_t i = a.size(); i-- > 0;) {
+                x = (x << LIMB_BITS) | a[i];
+            }
+            return x;
+        }
+
+        uint64_t isqrt64(uint64_t x)
+        {
+            auto s = static_cast<uint64_t>(std::sqrt(static_cast<double>(x)));
+
+            // The double estimate is off by at most one either way
+            while (s && s > x / s) {
+                --s;
+            }
+            while (s + 1 <= x / (s + 1)) {
+                ++s;
+            }
+            return s;
+        }
+
+        // Requires a >= 2^(bits - 2) with `bits` even; the recursion splits a into quarters of b bits.
+        void sqrt_rem_normalized(const Natural &a, std::size_t bits, Natural &s, Natural &r)
+        {
+            if (bits <= 64)
+            {
+                uint64_t x = to_uint64(a);
+                uint64_t root = isqrt64(x);
+
+                s = from_uint64(root);
+                r = from_uint64(x - root * root);
+                return;
+            }
+            const std::size_t b = bits / 4;
+
+            Natural a1 = truncate(shr(a, b), b);
+            Natural a0 = truncate(a, b);
+
+            Natural s1, r1;
+
+            sqrt_rem_normalized(shr(a, 2 * b), bits - 2 * b, s1, r1);
+
+            // (q, u) = divmod(r1 * 2^b + a1, 2 * s1)
+            Natural q, u;
+
+            divmod(add(shl(r1, b), a1), shl(s1, 1), q, u);
+
+            s = add(shl(s1, b), q);
+
+            // r = u * 2^b + a0 - q^2, corrected once if negative
+            Natural t = add(shl(u, b), a0);
+            Natural q2 = sqr(q);
+
+            if (compare(t, q2) >= 0) {
+                r = sub(t, q2);
+            }
+            else
+            {
+                r = sub(add(t, sub(shl(s, 1), { 1 })), q2);
+                s = sub(s, { 1 });
+            }
+        }
+
+        // x^e by repeated squaring
+        Natural pow(const Natural &x, unsigned e)
+        {
+            Natural result = { 1 };
+            Natural base = x;
+
+            for (; e; e >>= 1)
+            {
+                if (e & 1) {
+                    result = mul(result, base);
+                }
+                if (e > 1) {
+                    base = sqr(base);
+                }
+            }
+            return result;
+        }
+
+        // floor(((k - 1) x + floor(a / x^(k - 1))) / k), never below floor(a^(1/k)) for x > 0
+        Natural newton_root_step(const Natural &a, const Natural &x, unsigned k)
+        {
+            Natural q, r;
+
+            divmod(a, pow(x, k - 1), q, r);
+            divmod(add(mul_small(x, k - 1), q), from_uint64(k), q, r);
+
+            return q;
+        }
+
+        // Newton's iteration from x >= floor(a^(1/k)); the iterates decrease until they reach the root
+        Natural newton_root(const Natural &a, Natural x, unsigned k)
+        {
+            while (true)
+            {
+                Natural y = newton_root_step(a, x, k);
+
+                if (compare(y, x) >= 0) {
+                    return x;
+                }
+                x = std::move(y);
+            }
+        }
+    }
+
+    void sqrt_rem(const Natural &a, Natural &s, Natural &r)
+    {
+        if (a.empty())
+        {
+            s.clear();
+            r.clear();
+            return;
+        }
+        std::size_t bits = bit_length(a);
+
+        sqrt_rem_normalized(a, bits + (bits & 1), s, r);
+    }
+
+    Natural isqrt(const Natural &a)
+    {
+        Natural s, r;
+
+        sqrt_rem(a, s, r);
+        return s;
+    }
+
+    Natural iroot(const Natural &a, unsigned k)
+    {
+        if (!k) {
+            throw std::invalid_argument("Arithmetic Error: iroot(a, k) requires k >= 1.");
+        }
+        if (k == 1 || a.empty()) {
+            return a;
+        }
+        if (k == 2) {
+            return isqrt(a);
+        }
+        const std::size_t bits = bit_length(a);
+
+        if (bits <= k) {
+            return { 1 };
+        }
+        const std::size_t root_bits = (bits + k - 1) / k;
+
+        if (root_bits <= 32)
+        {
+            // Seed from log2(a) taken from the leading 64 bits, then let Newton settle the last bits
+            std::size_t shift = bits > 64 ? bits - 64 : 0;
+            double log2_a = std::log2(static_cast<double>(to_uint64(shr(a, shift)))) + static_cast<double>(shift);
+            auto seed = static_cast<uint64_t>(std::exp2(log2_a / k)) + 1;
+
+            return newton_root(a, newton_root_step(a, from_uint64(seed), k), k);
+        }
+        // The root of the top half of the digits gives the top half of the root's bits.
+        // With x = floor((a >> kh)^(1/k)) we have ((x + 1) * 2^h)^k > a, a seed from above.
+        const std::size_t h = root_bits / 2;
+
+        Natural x = iroot(shr(a, k * h), k);
+
+        // One step from this seed lands on the root or just above it; confirming with a power is
+        // cheaper than the division of a second step.
+        x = newton_root_step(a, shl(add(x, { 1 }), h), k);
+
+        for (int i = 0; i < 2; ++i)
+        {
+            if (compare(pow(x, k), a) <= 0) {
+                return x;
+            }
+            x = sub(x, { 1 });
+        }
+        return newton_root(a, x, k);
+    }
+
+
+    /* * * * * * * * * * * Greatest common divisor * * * * * * * * * * */
+
+    namespace
+    {
+        // Operands of at least this many limbs are reduced by the half-GCD instead of Lehmer steps
+        constexpr std::size_t GCD_HGCD_THRESHOLD = 5000;
+
+        // Below this many limbs the half-GCD recursion bottoms out into Lehmer steps
+        constexpr std::size_t HGCD_THRESHOLD = 200;
+
+        // Lehmer cofactors are kept below 2^31 so that applying them never overflows
+        constexpr int64_t COFACTOR_LIMIT = static_cast<int64_t>(1) << 31;
+
+
+        // -------- Signed arithmetic --------
+        Signed make_signed(Natural mag, bool negative = false)
+        {
+            Signed x;
+
+            x.negative = negative && !mag.empty();
+            x.mag = std::move(mag);
+
+            return x;
+        }
+
+        Signed s_add(const Signed &x, const Signed &y)
+        {
+            if (x.negative == y.negative) {
+                return make_signed(add(x.mag, y.mag), x.negative);
+            }
+            if (compare(x.mag, y.mag) >= 0) {
+                return make_signed(sub(x.mag, y.mag), x.negative);
+            }
+            return make_signed(sub(y.mag, x.mag), y.negative);
+        }
+
+        Signed s_mul(const Signed &x, const Signed &y) {
+            return make_signed(mul(x.mag, y.mag), x.negative != y.negative);
+        }
+
+        Signed from_small(int64_t c)
+        {
+            uint64_t mag = c < 0 ? 0 - static_cast<uint64_t>(c) : static_cast<uint64_t>(c);
+
+            return make_signed(from_uint64(mag), c < 0);
+        }
+
+
+        // X*x + Y*y in a single pass, for |X|, |Y| < 2^31
+        Signed lincomb(const Signed &x, int64_t X, const Signed &y, int64_t Y)
+        {
+            if (x.negative) X = -X;
+            if (y.negative) Y = -Y;
+
+            const std::size_t n = std::max(x.mag.size(), y.mag.size());
+
+            Natural r(n + 2);
+
+            int64_t cx = 0, cy = 0;
+            dlimb_t c = 0;
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                int64_t px = X * static_cast<int64_t>(i < x.mag.size() ? x.mag[i] : 0) + cx;
+                int64_t py = Y * static_cast<int64_t>(i < y.mag.size() ? y.mag[i] : 0) + cy;
+
+                cx = px >> LIMB_BITS;
+                cy = py >> LIMB_BITS;
+
+                c += static_cast<dlimb_t>(static_cast<limb_t>(px)) + static_cast<limb_t>(py);
+                r[i] = static_cast<limb_t>(c);
+                c >>= LIMB_BITS;
+            }
+            int64_t top = cx + cy + static_cast<int64_t>(c);
+
+            r[n] = static_cast<limb_t>(top);
+            r[n + 1] = static_cast<limb_t>(top >> LIMB_BITS);
+
+            // Negative results come out in two's complement
+            if (top < 0)
+            {
+                dlimb_t borrow = 1;
+
+                for (limb_t &limb : r)
+                {
+                    borrow += static_cast<limb_t>(~limb);
+                    limb = static_cast<limb_t>(borrow);
+                    borrow >>= LIMB_BITS;
+                }
+            }
+            trim(r);
+            return make_signed(std::move(r), top < 0);
+        }
+
+        bool is_small(const Signed &x) {
+            return x.mag.empty() || (x.mag.size() == 1 && x.mag[0] < COFACTOR_LIMIT);
+        }
+
+        int64_t to_small(const Signed &x) {
+            return x.mag.empty() ? 0 : (x.negative ? -static_cast<int64_t>(x.mag[0]) : x.mag[0]);
+        }
+
+
+        // -------- 2x2 transforms --------
+
+        // (a', b') = (u00 a + u01 b, u10 a + u11 b); every transform used here has determinant +-1,
+        // so gcd(a', b') = gcd(a, b) no matter how the quotients were obtained.
+        struct Matrix
+        {
+            Signed u00, u01, u10, u11;
+        };
+
+        Matrix identity()
+        {
+            Matrix m;
+
+            m.u00.mag = { 1 };
+            m.u11.mag = { 1 };
+
+            return m;
+        }
+
+        bool is_small(const Matrix &m) {
+            return is_small(m.u00) && is_small(m.u01) && is_small(m.u10) && is_small(m.u11);
+        }
+
+        // second * first
+        Matrix compose(const Matrix &second, const Matrix &first)
+        {
+            Matrix r;
+
+            if (is_small(second))
+            {
+                int64_t A = to_small(second.u00), B = to_small(second.u01);
+                int64_t C = to_small(second.u10), D = to_small(second.u11);
+
+                r.u00 = lincomb(first.u00, A, first.u10, B);
+                r.u01 = lincomb(first.u01, A, first.u11, B);
+                r.u10 = lincomb(first.u00, C, first.u10, D);
+                r.u11 = lincomb(first.u01, C, first.u11, D);
+
+                return r;
+            }
+            r.u00 = s_add(s_mul(second.u00, first.u00), s_mul(second.u01, first.u10));
+            r.u01 = s_add(s_mul(second.u00, first.u01), s_mul(second.u01, first.u11));
+            r.u10 = s_add(s_mul(second.u10, first.u00), s_mul(second.u11, first.u10));
+            r.u11 = s_add(s_mul(second.u10, first.u01), s_mul(second.u11, first.u11));
+
+            return r;
+        }
+
+        // Applies the transform to the pair (x, y) of cofactors
+        void apply_cofactors(const Matrix &m, Signed &x, Signed &y)
+        {
+            if (is_small(m))
+            {
+                Signed nx = lincomb(x, to_small(m.u00), y, to_small(m.u01));
+                Signed ny = lincomb(x, to_small(m.u10), y, to_small(m.u11));
+
+                x = std::move(nx);
+                y = std::move(ny);
+                return;
+            }
+            Signed nx = s_add(s_mul(m.u00, x), s_mul(m.u01, y));
+            Signed ny = s_add(s_mul(m.u10, x), s_mul(m.u11, y));
+
+            x = std::move(nx);
+            y = std::move(ny);
+        }
+
+        // Applies the transform to (a, b), then flips signs and orders the rows so that a >= b >= 0
+        void apply_reduce(Matrix &m, Natural &a, Natural &b)
+        {
+            Signed sa = make_signed(a), sb = make_signed(b);
+            Signed na = s_add(s_mul(m.u00, sa), s_mul(m.u01, sb));
+            Signed nb = s_add(s_mul(m.u10, sa), s_mul(m.u11, sb));
+
+            if (na.negative)
+            {
+                m.u00.negative = !m.u00.negative && !m.u00.mag.empty();
+                m.u01.negative = !m.u01.negative && !m.u01.mag.empty();
+            }
+            if (nb.negative)
+            {
+                m.u10.negative = !m.u10.negative && !m.u10.mag.empty();
+                m.u11.negative = !m.u11.negative && !m.u11.mag.empty();
+            }
+            a = std::move(na.mag);
+            b = std::move(nb.mag);
+
+            if (compare(a, b) < 0)
+            {
+                std::swap(a, b);
+                std::swap(m.u00, m.u10);
+                std::swap(m.u01, m.u11);
+            }
+        }
+
+
+        // -------- Euclidean steps --------
+
+        uint64_t binary_gcd(uint64_t u, uint64_t v)
+        {
+            if (!u) return v;
+            if (!v) return u;
+
+            int shift = std::countr_zero(u | v);
+
+            u >>= std::countr_zero(u);
+
+            do
+            {
+                v >>= std::countr_zero(v);
+
+                if (u > v) std::swap(u, v);
+
+                v -= u;
+            }
+            while (v);
+
+            return u << shift;
+        }
+
+        // Bits [shift, shift + 62) of a
+        int64_t leading_bits(const Natural &a, std::size_t shift)
+        {
+            auto limb = [&a](std::size_t i) -> uint64_t { return i < a.size() ? a[i] : 0; };
+
+            const std::size_t low = shift / LIMB_BITS;
+            const int offset = static_cast<int>(shift % LIMB_BITS);
+
+            uint64_t x = ((limb(low + 1) << LIMB_BITS) | limb(low)) >> offset;
+
+            if (offset) {
+                x |= limb(low + 2) << (2 * LIMB_BITS - offset);
+            }
+            return static_cast<int64_t>(x & ((static_cast<uint64_t>(1) << 62) - 1));
+        }
+
+        // Double-digit Lehmer step (Knuth 4.5.2, Algorithm L) on the leading 62 bits of a >= b > 0.
+        // Returns false when no quotient could be certified from the leading bits.
+        bool lehmer_step(Natural &a, Natural &b, Matrix &step)
+        {
+            std::size_t bits = bit_length(a);
+            std::size_t shift = bits > 62 ? bits - 62 : 0;
+
+            int64_t ah = leading_bits(a, shift);
+            int64_t bh = leading_bits(b, shift);
+
+            int64_t A = 1, B = 0, C = 0, D = 1;
+
+            while (bh + C > 0 && bh + D > 0)
+            {
+                int64_t q = (ah + A) / (bh + C);
+
+                if (q != (ah + B) / (bh + D) || q >= COFACTOR_LIMIT) break;
+
+                int64_t nC = A - q * C;
+                int64_t nD = B - q * D;
+
+                if (nC >= COFACTOR_LIMIT || -nC >= COFACTOR_LIMIT) break;
+                if (nD >= COFACTOR_LIMIT || -nD >= COFACTOR_LIMIT) break;
+
+                A = C; B = D;
+                C = nC; D = nD;
+
+                int64_t t = ah - q * bh;
+
+                ah = bh;
+                bh = t;
+            }
+            if (!B) {
+                return false;
+            }
+            Signed sa = make_signed(a), sb = make_signed(b);
+
+            Signed na = lincomb(sa, A, sb, B);
+            Signed nb = lincomb(sa, C, sb, D);
+
+            if (na.negative || nb.negative || compare(na.mag, nb.mag) < 0) {
+                return false;
+            }
+            a = std::move(na.mag);
+            b = std::move(nb.mag);
+
+            step.u00 = from_small(A);
+            step.u01 = from_small(B);
+            step.u10 = from_small(C);
+            step.u11 = from_small(D);
+
+            return true;
+        }
+
+        // (a, b) <- (b, a mod b)
+        Matrix division_step(Natural &a, Natural &b)
+        {
+            Natural q, r;
+
+            divmod(a, b, q, r);
+
+            a = std::move(b);
+            b = std::move(r);
+
+            Matrix step;
+
+            step.u01.mag = { 1 };
+            step.u10.mag = { 1 };
+            step.u11 = make_signed(std::move(q), true);
+
+            return step;
+        }
+
+        Matrix euclid_step(Natural &a, Natural &b)
+        {
+            Matrix step;
+
+            if (a.size() <= b.size() + 1 && lehmer_step(a, b, step)) {
+                return step;
+            }
+            return division_step(a, b);
+        }
+
+        // Reduces a >= b >= 0 until b has at most half of a's original bit length.
+        // The leading halves are reduced recursively and the resulting transforms are applied
+        // to the full operands, so the cost is O(M(n) log n) instead of quadratic.
+        Matrix hgcd(Natural &a, Natural &b)
+        {
+            Matrix u = identity();
+
+            const std::size_t half = bit_length(a) / 2;
+
+            auto reduced = [&]() { return b.empty() || bit_length(b) <= half; };
+
+            if (a.size() >= HGCD_THRESHOLD)
+            {
+                // First quarter: reduce the top half of the bits
+                Natural ah = shr(a, half);
+                Natural bh = shr(b, half);
+
+                u = hgcd(ah, bh);
+                apply_reduce(u, a, b);
+
+                if (!reduced())
+                {
+                    u = compose(division_step(a, b), u);
+                }
+                // Second quarter: the leading 2 (len(a) - half) bits bring a down to about half
+                if (!reduced())
+                {
+                    std::size_t bits = bit_length(a);
+                    std::size_t shift = 2 * half > bits ? 2 * half - bits : 0;
+
+                    Natural at = shr(a, shift);
+                    Natural bt = shr(b, shift);
+
+                    Matrix v = hgcd(at, bt);
+
+                    apply_reduce(v, a, b);
+                    u = compose(v, u);
+                }
+            }
+            while (!reduced()) {
+                u = compose(euclid_step(a, b), u);
+            }
+            return u;
+        }
+
+        // Euclid's algorithm on a >= b; tracks the cofactors of the original a when sa and sb are set
+        Natural gcd_loop(Natural a, Natural b, Signed *sa, Signed *sb)
+        {
+            while (!b.empty())
+            {
+                if (!sa && a.size() <= 2) {
+                    return from_uint64(binary_gcd(to_uint64(a), to_uint64(b)));
+                }
+                Matrix step;
+
+                if (b.size() >= GCD_HGCD_THRESHOLD && a.size() <= b.size() + 1)
+                    step = hgcd(a, b);
+                else
+                    step = euclid_step(a, b);
+
+                if (sa) {
+                    apply_cofactors(step, *sa, *sb);
+                }
+            }
+            return a;
+        }
+    }
+
+    Natural gcd(Natural a, Natural b)
+    {
+        if (compare(a, b) < 0) {
+            std::swap(a, b);
+        }
+        return gcd_loop(std::move(a), std::move(b), nullptr, nullptr);
+    }
+
+    Natural gcd_ext(const Natural &a, const Natural &b, Signed &s, Signed &t)
+    {
+        if (b.empty())
+        {
+            s = make_signed(a.empty() ? Natural() : Natural{ 1 });
+            t = Signed();
+            return a;
+        }
+        // Cofactors of a for the current pair
+        Signed sa, sb;
+
+        Natural g;
+
+        if (compare(a, b) >= 0)
+        {
+            sa.mag = { 1 };
+            g = gcd_loop(a, b, &sa, &sb);
+        }
+        else
+        {
+            sb.mag = { 1 };
+            g = gcd_loop(b, a, &sa, &sb);
+        }
+        // Normalize s into (-b/2g, b/2g], then t = (g - s*a) / b exactly
+        Natural bg, rem;
+
+        divmod(b, g, bg, rem);
+        divmod(sa.mag, bg, rem, s.mag);
+
+        if (sa.negative && !s.mag.empty()) {
+            s.mag = sub(bg, s.mag);
+        }
+        s.negative = false;
+
+        if (compare(shl(s.mag, 1), bg) > 0) {
+            s = make_signed(sub(bg, s.mag), true);
+        }
+        Signed rest = s_add(make_signed(g), s_mul(make_signed(s.mag, !s.negative), make_signed(a)));
+
+        Natural q;
+
+        divmod(rest.mag, b, q, rem);
+        t = make_signed(std::move(q), rest.negative);
+
+        return g;
+    }
+
+    Natural truncate(const Natural &a, std::size_t bits)
+    {
+        if (bits >= a.size() * LIMB_BITS) {
+            return a;
+        }
+        const std::size_t limbs = (bits + LIMB_BITS - 1) / LIMB_BITS;
+
+        Natural r(a.begin(), a.begin() + static_cast<std::ptrdiff_t>(limbs));
+
+        if (bits % LIMB_BITS) {
+            r.back() &= (static_cast<limb_t>(1) << (bits % LIMB_BITS)) - 1;
+        }
+        trim(r);
+        return r;
+    }
+
+    Natural inverse_pow2(const Natural &a, std::size_t bits)
+    {
+        if (a.empty() || !(a[0] & 1)) {
+            throw std::invalid_argument("Arithmetic Error: only odd numbers are invertible modulo 2^k.");
+        }
+        // Inverse modulo 2^32 from the low limb, then x <- x (2 - a x) doubles the precision each step
+        limb_t inv = a[0];
+
+        for (int i = 0; i < 4; ++i) {
+            inv *= 2 - a[0] * inv;
+        }
+        Natural x = truncate({ inv }, bits);
+
+        for (std::size_t precision = LIMB_BITS; precision < bits;)
+        {
+            precision = std::min(2 * precision, bits);
+
+            Natural ax = truncate(mul(truncate(a, precision), x), precision);
+            Natural two_minus_ax = truncate(sub(add(shl({ 1 }, precision), { 2 }), ax), precision);
+
+            x = truncate(mul(x, two_minus_ax), precision);
+        }
+        return x;
+    }
+
+
+    /* * * * * * * * * * * Bitwise operations * * * * * * * * * * */
+
+    namespace
+    {
+        // Two's complement of a, in place
+        void negate(Natural &a)
+        {
+            limb_t carry = 1;
+
+            for (limb_t &limb : a)
+            {
+                limb = ~limb + carry;
+                carry = carry && !limb;
+            }
+        }
+
+        // The low n limbs of the two's-complement form of a
+        Natural twos_complement(const Signed &a, std::size_t n)
+        {
+            Natural r(a.mag);
+
+            r.resize(n, 0);
+
+            if (a.negative) {
+                negate(r);
+            }
+            return r;
+        }
+    }
+
+    Signed bitwise(const Signed &a, const Signed &b, BitOp op)
+    {
+        // One extra limb holds nothing but sign bits
+        const std::size_t n = std::max(a.mag.size(), b.mag.size()) + 1;
+
+        Natural x = twos_complement(a, n);
+        Natural y = twos_complement(b, n);
+
+        switch (op)
+        {
+            case BitOp::AND:
+                for (std::size_t i = 0; i < n; ++i) x[i] &= y[i];
+                break;
+            case BitOp::OR:
+                for (std::size_t i = 0; i < n; ++i) x[i] |= y[i];
+                break;
+            case BitOp::XOR:
+                for (std::size_t i = 0; i < n; ++i) x[i] ^= y[i];
+                break;
+        }
+        bool negative = x.back() >> (LIMB_BITS - 1);
+
+        if (negative) {
+            negate(x);
+        }
+        trim(x);
+
+        return { std::move(x), negative };
+    }
+
+
+    /* * * * * * * * * * * Montgomery reduction * * * * * * * * * * */
+
+    Montgomery::Montgomery(const Natural &modulus) : m(modulus)
+    {
+        if (m.empty() || !(m[0] & 1)) {
+            throw std::invalid_argument("Arithmetic Error: Montgomery reduction requires an odd modulus.");
+        }
+        // Newton iteration for m[0]^-1 mod 2^32: each step doubles the number of correct bits
+        limb_t inv = m[0];
+
+        for (int i = 0; i < 4; ++i) {
+            inv *= 2 - m[0] * inv;
+        }
+        m_inv = static_cast<limb_t>(0u - inv);
+
+        Natural power(m.size() + 1, 0);
+
+        power.back() = 1;
+        r1 = mod(power, m);
+
+        power.assign(2 * m.size() + 1, 0);
+        power.back() = 1;
+        r2 = mod(power, m);
+    }
+
+    Natural Montgomery::redc(Natural t) const
+    {
+        const std::size_t n = m.size();
+
+        t.resize(2 * n + 1, 0);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const dlimb_t u = static_cast<limb_t>(t[i] * m_inv);
+            dlimb_t carry = 0;
+
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                carry += u * m[j] + t[i + j];
+                t[i + j] = static_cast<limb_t>(carry);
+                carry >>= LIMB_BITS;
+            }
+            for (std::size_t k = i + n; carry; ++k)
+            {
+                carry += t[k];
+                t[k] = static_cast<limb_t>(carry);
+                carry >>= LIMB_BITS;
+            }
+        }
+        Natural r(t.begin() + static_cast<std::ptrdiff_t>(n), t.end());
+
+        trim(r);
+
+        if (compare(r, m) >= 0) {
+            r = sub(r, m);
+        }
+        return r;
+    }
+
+    Natural Montgomery::to_form(const Natural &x) const {
+        return redc(Limbs::mul(x, r2));
+    }
+
+    Natural Montgomery::from_form(const Natural &x) const {
+        return redc(x);
+    }
+
+    Natural Montgomery::mul(const Natural &a, const Natural &b) const {
+        return redc(Limbs::mul(a, b));
+    }
+
+    Natural Montgomery::sqr(const Natural &a) const {
+        return redc(Limbs::sqr(a));
+    }
+
+
+    /* * * * * * * * * * * Barrett reduction * * * * * * * * * * */
+
+    Barrett::Barrett(const Natural &modulus) : m(modulus), k(modulus.size())
+    {
+        if (m.empty() || (m.size() == 1 && m[0] == 1)) {
+            throw std::invalid_argument("Arithmetic Error: Barrett reduction requires a modulus > 1.");
+        }
+        // mu = floor(B^2k / m)
+        Natural power(2 * k + 1, 0);
+        Natural rem;
+
+        power.back() = 1;
+        divmod(power, m, mu, rem);
+    }
+
+    Natural Barrett::reduce(const Natural &x) const
+    {
+        if (x.size() < k) {
+            return compare(x, m) >= 0 ? sub(x, m) : x;
+        }
+        // q = floor(floor(x / B^(k-1)) * mu / B^(k+1)) underestimates x / m by at most 2
+        Natural q1(x.begin() + static_cast<std::ptrdiff_t>(k - 1), x.end());
+        Natural q2 = Limbs::mul(q1, mu);
+        Natural q3;
+
+        if (q2.size() > k + 1) {
+            q3.assign(q2.begin() + static_cast<std::ptrdiff_t>(k + 1), q2.end());
+        }
+        Natural r = sub(x, Limbs::mul(q3, m));
+
+        while (compare(r, m) >= 0) {
+            r = sub(r, m);
+        }
+        return r;
+    }
+
+    Natural Barrett::mul(const Natural &a, const Natural &b) const {
+        return reduce(Limbs::mul(a, b));
+    }
+
+    Natural Barrett::sqr(const Natural &a) const {
+        return reduce(Limbs::sqr(a));
+    }
+}
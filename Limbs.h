@@ -0,0 +1,224 @@
+#ifndef BIGINTEGER_LIMBS_H
+#define BIGINTEGER_LIMBS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+/*
+ * Binary limb kernels used by the number-theoretic functions of BigInteger.
+ *
+ * A Natural is an unsigned integer stored as base 2^32 limbs, least significant first,
+ * without leading zero limbs; zero is the empty vector.
+ */
+namespace Limbs
+{
+    using limb_t  = uint32_t;
+    using dlimb_t = uint64_t;
+
+    using Natural = std::vector<limb_t>;
+
+    constexpr int LIMB_BITS = 32;
+
+
+    // -------- Basic operations --------
+    void trim(Natural &);
+
+    Natural from_uint64(uint64_t);
+
+    int compare(const Natural &, const Natural &);
+
+    Natural add(const Natural &, const Natural &);
+
+    // Requires a >= b
+    Natural sub(const Natural &a, const Natural &b);
+
+    Natural mul(const Natural &, const Natural &);
+    Natural sqr(const Natural &);
+
+    Natural mul_small(const Natural &, limb_t);
+
+    // Knuth's Algorithm D, or a Newton reciprocal for long divisors; throws on division by zero.
+    void divmod(const Natural &a, const Natural &b, Natural &q, Natural &r);
+
+    Natural mod(const Natural &a, const Natural &b);
+
+    limb_t mod_small(const Natural &a, limb_t b);
+
+    Natural shl(const Natural &, std::size_t bits);
+    Natural shr(const Natural &, std::size_t bits);
+
+    std::size_t bit_length(const Natural &);
+
+    bool test_bit(const Natural &, std::size_t bit);
+
+
+    // -------- Roots --------
+
+    // s = floor(sqrt(a)), r = a - s^2, by Zimmermann's Karatsuba square root
+    void sqrt_rem(const Natural &a, Natural &s, Natural &r);
+
+    Natural isqrt(const Natural &a);
+
+    // floor(a^(1/k)) for k >= 1
+    Natural iroot(const Natural &a, unsigned k);
+
+
+    // -------- Greatest common divisor --------
+
+    // Sign-magnitude integer, used for Bezout cofactors
+    struct Signed
+    {
+        Natural mag;
+        bool negative = false;
+    };
+
+    Natural gcd(Natural a, Natural b);
+
+    // Returns g = gcd(a, b) and s, t with g = s*a + t*b and |s| <= b / 2g, |t| <= a / 2g
+    Natural gcd_ext(const Natural &a, const Natural &b, Signed &s, Signed &t);
+
+    // Inverse of an odd a modulo 2^bits by Newton/Hensel lifting
+    Natural inverse_pow2(const Natural &a, std::size_t bits);
+
+    // Low `bits` bits of a
+    Natural truncate(const Natural &a, std::size_t bits);
+
+
+    // -------- Bitwise operations --------
+
+    enum class BitOp { AND, OR, XOR };
+
+    // a op b on the infinite two's-complement forms of sign-magnitude operands (as GMP does)
+    Signed bitwise(const Signed &a, const Signed &b, BitOp op);
+
+
+    // -------- Modular reduction --------
+
+    // Montgomery arithmetic for odd moduli; residues are kept as x * R mod m with R = 2^(32n).
+    class Montgomery
+    {
+    private:
+        Natural m;
+        Natural r1;
+        Natural r2;
+
+        limb_t m_inv;
+
+        Natural redc(Natural t) const;
+
+    public:
+        explicit Montgomery(const Natural &modulus);
+
+        const Natural &modulus() const { return m; }
+
+        Natural one() const { return r1; }
+
+        // Requires x < m
+        Natural to_form(const Natural &x) const;
+        Natural from_form(const Natural &x) const;
+
+        Natural mul(const Natural &a, const Natural &b) const;
+        Natural sqr(const Natural &a) const;
+    };
+
+    // Barrett reduction for any modulus > 1; residues are plain values in [0, m).
+    class Barrett
+    {
+    private:
+        Natural m;
+        Natural mu;
+
+        std::size_t k;
+
+    public:
+        explicit Barrett(const Natural &modulus);
+
+        const Natural &modulus() const { return m; }
+
+        Natural one() const { return { 1 }; }
+
+        // Requires x < m
+        Natural to_form(const Natural &x) const { return x; }
+        Natural from_form(const Natural &x) const { return x; }
+
+        // Requires x < B^2k for a modulus of k limbs, in particular any x < m^2
+        Natural reduce(const Natural &x) const;
+
+        Natural mul(const Natural &a, const Natural &b) const;
+        Natural sqr(const Natural &a) const;
+    };
+
+
+    // -------- Exponentiation --------
+
+    // Sliding-window exponentiation of a residue already in the reducer's form.
+    template <typename Reducer>
+    Natural window_pow(const Reducer &ctx, const Natural &base, const Natural &exponent)
+    {
+        std::size_t bits = bit_length(exponent);
+
+        if (!bits) {
+            return ctx.one();
+        }
+        int w = bits <= 24 ? 1 : bits <= 80 ? 3 : bits <= 240 ? 4 : bits <= 672 ? 5 : 6;
+
+        // table[i] = base^(2i + 1)
+        std::vector<Natural> table(static_cast<std::size_t>(1) << (w - 1));
+
+        table[0] = base;
+
+        if (w > 1)
+        {
+            Natural base_sqr = ctx.sqr(base);
+
+            for (std::size_t i = 1; i < table.size(); ++i) {
+                table[i] = ctx.mul(table[i - 1], base_sqr);
+            }
+        }
+        Natural result = ctx.one();
+        bool started = false;
+
+        std::size_t i = bits;
+
+        while (i > 0)
+        {
+            if (!test_bit(exponent, i - 1))
+            {
+                if (started) {
+                    result = ctx.sqr(result);
+                }
+                --i;
+                continue;
+            }
+            // Longest window [low, i) of at most w bits ending in a set bit
+            std::size_t low = i > static_cast<std::size_t>(w) ? i - w : 0;
+
+            while (!test_bit(exponent, low)) {
+                ++low;
+            }
+            std::size_t value = 0;
+
+            for (std::size_t j = i; j > low; --j) {
+                value = (value << 1) | static_cast<std::size_t>(test_bit(exponent, j - 1));
+            }
+            if (started)
+            {
+                for (std::size_t j = low; j < i; ++j) {
+                    result = ctx.sqr(result);
+                }
+                result = ctx.mul(result, table[value >> 1]);
+            }
+            else
+            {
+                result = table[value >> 1];
+                started = true;
+            }
+            i = low;
+        }
+        return result;
+    }
+}
+
+#endif //BIGINTEGER_LIMBS_H
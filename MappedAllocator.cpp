@@ -0,0 +1,169 @@
+#include "MappedAllocator.h"
+
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstdlib>
+#endif
+
+
+namespace
+{
+    // Every block starts with a header recording how it was obtained.
+    struct BlockHeader
+    {
+        std::size_t length;
+        bool mapped;
+    };
+
+    constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t)
+                                        * ((sizeof(BlockHeader) + alignof(std::max_align_t) - 1)
+                                           / alignof(std::max_align_t));
+
+    std::atomic<std::size_t> map_threshold{ SIZE_MAX };
+
+    std::mutex directory_mutex;
+    std::string map_directory = ".";
+
+
+    void *map_block(std::size_t length)
+    {
+        std::string directory;
+        {
+            std::lock_guard<std::mutex> lock(directory_mutex);
+            directory = map_directory;
+        }
+#ifdef _WIN32
+        char path[MAX_PATH];
+
+        if (!GetTempFileNameA(directory.c_str(), "big", 0, path)) {
+            return nullptr;
+        }
+        HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+                                            static_cast<DWORD>(static_cast<uint64_t>(length) >> 32),
+                                            static_cast<DWORD>(length & 0xFFFFFFFFu), nullptr);
+        void *p = nullptr;
+
+        if (mapping)
+        {
+            p = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, length);
+            CloseHandle(mapping);
+        }
+        // The view keeps the file alive; it is deleted once unmapped.
+        CloseHandle(file);
+
+        return p;
+#else
+        std::string path = directory + "/bigint-XXXXXX";
+
+        int fd = mkstemp(path.data());
+
+        if (fd < 0) {
+            return nullptr;
+        }
+        unlink(path.c_str());
+
+        if (ftruncate(fd, static_cast<off_t>(length)) != 0)
+        {
+            close(fd);
+            return nullptr;
+        }
+        void *p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        close(fd);
+
+        if (p == MAP_FAILED) {
+            return nullptr;
+        }
+        // Digit kernels stream through their operands front to back.
+        madvise(p, length, MADV_SEQUENTIAL);
+
+        return p;
+#endif
+    }
+
+    void unmap_block(void *p, std::size_t length)
+    {
+#ifdef _WIN32
+        (void)length;
+        UnmapViewOfFile(p);
+#else
+        munmap(p, length);
+#endif
+    }
+}
+
+
+void MappedStorage::enable(std::size_t threshold, const std::string &directory)
+{
+    {
+        std::lock_guard<std::mutex> lock(directory_mutex);
+        map_directory = directory;
+    }
+    map_threshold = threshold;
+}
+
+void MappedStorage::disable() {
+    map_threshold = SIZE_MAX;
+}
+
+std::size_t MappedStorage::threshold() {
+    return map_threshold;
+}
+
+void *MappedStorage::allocate(std::size_t bytes)
+{
+    if (bytes > SIZE_MAX - HEADER_SIZE) {
+        throw std::bad_alloc();
+    }
+    std::size_t length = bytes + HEADER_SIZE;
+
+    void *block = nullptr;
+    bool mapped = false;
+
+    if (bytes >= map_threshold)
+    {
+        block = map_block(length);
+        mapped = (block != nullptr);
+    }
+    // Fall back to the heap if no mapping could be created.
+    if (!block) {
+        block = ::operator new(length);
+    }
+    auto *header = static_cast<BlockHeader *>(block);
+
+    header->length = length;
+    header->mapped = mapped;
+
+    return static_cast<char *>(block) + HEADER_SIZE;
+}
+
+void MappedStorage::deallocate(void *p) noexcept
+{
+    if (!p) {
+        return;
+    }
+    void *block = static_cast<char *>(p) - HEADER_SIZE;
+
+    auto *header = static_cast<BlockHeader *>(block);
+
+    if (header->mapped) {
+        unmap_block(block, header->length);
+    }
+    else {
+        ::operator delete(block);
+    }
+}
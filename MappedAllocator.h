@@ -0,0 +1,62 @@
+#ifndef BIGINTEGER_MAPPEDALLOCATOR_H
+#define BIGINTEGER_MAPPEDALLOCATOR_H
+
+#include <cstddef>
+#include <string>
+#include <new>
+
+
+/*
+ * Out-of-core storage for BigInteger digits.
+ *
+ * Blocks smaller than the configured threshold come from the heap. Larger blocks are placed in an
+ * unlinked temporary file which is memory-mapped, so the kernel pages digits to disk instead of swap
+ * and operands may exceed physical memory. Mapping is disabled until MappedStorage::enable() is called.
+ */
+class MappedStorage
+{
+public:
+    // Map every block of at least `threshold` bytes into a temporary file created in `directory`.
+    static void enable(std::size_t threshold, const std::string &directory = ".");
+
+    static void disable();
+
+    static std::size_t threshold();
+
+    static void *allocate(std::size_t bytes);
+
+    static void deallocate(void *p) noexcept;
+};
+
+
+template <typename T>
+class MappedAllocator
+{
+public:
+    using value_type = T;
+
+    MappedAllocator() noexcept = default;
+
+    template <typename U>
+    MappedAllocator(const MappedAllocator<U> &) noexcept {}
+
+    T *allocate(std::size_t n)
+    {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(MappedStorage::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, std::size_t) noexcept {
+        MappedStorage::deallocate(p);
+    }
+
+    template <typename U>
+    bool operator == (const MappedAllocator<U> &) const noexcept { return true; }
+
+    template <typename U>
+    bool operator != (const MappedAllocator<U> &) const noexcept { return false; }
+};
+
+#endif //BIGINTEGER_MAPPEDALLOCATOR_H
@@ -0,0 +1,129 @@
+#include "ModContext.h"
+
+
+/* * * * * * * * * * * Constructor * * * * * * * * * * */
+
+ModContext::ModContext(const BigInteger &modulus) : m(modulus), m_limbs(modulus.limbs())
+{
+    if (modulus <= BigConstants::ONE) {
+        throw std::invalid_argument("Arithmetic Error: ModContext requires a modulus > 1.");
+    }
+    if (m_limbs[0] & 1)
+        montgomery.emplace(m_limbs);
+    else
+        barrett.emplace(m_limbs);
+}
+
+/* * * * * * * * * * * Conversions * * * * * * * * * * */
+
+ModContext::Residue ModContext::to_residue(const BigInteger &x) const
+{
+    Limbs::Natural r = Limbs::mod(x.limbs(), m_limbs);
+
+    if (x < BigConstants::ZERO && !r.empty()) {
+        r = Limbs::sub(m_limbs, r);
+    }
+    return montgomery ? montgomery->to_form(r) : r;
+}
+
+std::vector<ModContext::Residue> ModContext::to_residues(const std::vector<BigInteger> &xs) const
+{
+    std::vector<Residue> residues;
+
+    residues.reserve(xs.size());
+
+    for (const BigInteger &x : xs) {
+        residues.push_back(to_residue(x));
+    }
+    return residues;
+}
+
+BigInteger ModContext::to_integer(const Residue &a) const {
+    return BigInteger::from_limbs(montgomery ? montgomery->from_form(a) : a);
+}
+
+BigInteger ModContext::reduce(const BigInteger &x) const
+{
+    Limbs::Natural r = Limbs::mod(x.limbs(), m_limbs);
+
+    if (x < BigConstants::ZERO && !r.empty()) {
+        r = Limbs::sub(m_limbs, r);
+    }
+    return BigInteger::from_limbs(r);
+}
+
+std::vector<BigInteger> ModContext::reduce(const std::vector<BigInteger> &xs) const
+{
+    std::vector<BigInteger> residues;
+
+    residues.reserve(xs.size());
+
+    for (const BigInteger &x : xs) {
+        residues.push_back(reduce(x));
+    }
+    return residues;
+}
+
+/* * * * * * * * * * * Residue arithmetic * * * * * * * * * * */
+
+ModContext::Residue ModContext::one() const {
+    return montgomery ? montgomery->one() : barrett->one();
+}
+
+ModContext::Residue ModContext::add(const Residue &a, const Residue &b) const
+{
+    Residue r = Limbs::add(a, b);
+
+    if (Limbs::compare(r, m_limbs) >= 0) {
+        r = Limbs::sub(r, m_limbs);
+    }
+    return r;
+}
+
+ModContext::Residue ModContext::sub(const Residue &a, const Residue &b) const
+{
+    if (Limbs::compare(a, b) >= 0) {
+        return Limbs::sub(a, b);
+    }
+    return Limbs::sub(Limbs::add(a, m_limbs), b);
+}
+
+ModContext::Residue ModContext::neg(const Residue &a) const
+{
+    if (a.empty()) {
+        return a;
+    }
+    return Limbs::sub(m_limbs, a);
+}
+
+ModContext::Residue ModContext::half(const Residue &a) const
+{
+    if (!a.empty() && (a[0] & 1)) {
+        return Limbs::shr(Limbs::add(a, m_limbs), 1);
+    }
+    return Limbs::shr(a, 1);
+}
+
+ModContext::Residue ModContext::mul(const Residue &a, const Residue &b) const {
+    return montgomery ? montgomery->mul(a, b) : barrett->mul(a, b);
+}
+
+ModContext::Residue ModContext::sqr(const Residue &a) const {
+    return montgomery ? montgomery->sqr(a) : barrett->sqr(a);
+}
+
+ModContext::Residue ModContext::pow(const Residue &a, const BigInteger &exp) const
+{
+    if (exp < BigConstants::ZERO) {
+        throw std::invalid_argument("Positive Exponents only");
+    }
+    return pow(a, exp.limbs());
+}
+
+ModContext::Residue ModContext::pow(const Residue &a, const Limbs::Natural &exp) const
+{
+    if (montgomery) {
+        return Limbs::window_pow(*montgomery, a, exp);
+    }
+    return Limbs::window_pow(*barrett, a, exp);
+}
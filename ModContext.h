@@ -0,0 +1,67 @@
+#ifndef BIGINTEGER_MODCONTEXT_H
+#define BIGINTEGER_MODCONTEXT_H
+
+#include "BigInteger.h"
+#include "Limbs.h"
+
+#include <optional>
+
+
+/*
+ * Arithmetic modulo a fixed m > 1.
+ *
+ * The reduction constants are computed once: Montgomery for odd m, Barrett for even m.
+ * Residues stay in the context's internal form (Montgomery form for odd m) across a whole
+ * computation and are only converted back by to_integer().
+ */
+class ModContext
+{
+public:
+    using Residue = Limbs::Natural;
+
+private:
+    BigInteger m;
+
+    Limbs::Natural m_limbs;
+
+    std::optional<Limbs::Montgomery> montgomery;
+    std::optional<Limbs::Barrett> barrett;
+
+public:
+    explicit ModContext(const BigInteger &modulus);
+
+    const BigInteger &modulus() const { return m; }
+
+    bool is_montgomery() const { return montgomery.has_value(); }
+
+
+    // Conversions
+    Residue to_residue(const BigInteger &) const;
+    std::vector<Residue> to_residues(const std::vector<BigInteger> &) const;
+
+    BigInteger to_integer(const Residue &) const;
+
+    // x mod m in [0, m)
+    BigInteger reduce(const BigInteger &) const;
+    std::vector<BigInteger> reduce(const std::vector<BigInteger> &) const;
+
+
+    // Residue arithmetic
+    Residue zero() const { return {}; }
+    Residue one() const;
+
+    Residue add(const Residue &, const Residue &) const;
+    Residue sub(const Residue &, const Residue &) const;
+    Residue neg(const Residue &) const;
+
+    // a / 2; m is odd or a is even
+    Residue half(const Residue &) const;
+
+    Residue mul(const Residue &, const Residue &) const;
+    Residue sqr(const Residue &) const;
+
+    Residue pow(const Residue &, const BigInteger &exp) const;
+    Residue pow(const Residue &, const Limbs::Natural &exp) const;
+};
+
+#endif //BIGINTEGER_MODCONTEXT_H
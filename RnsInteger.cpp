@@ -0,0 +1,373 @@
+#include "RnsInteger.h"
+
+#include <bit>
+#include <future>
+#include <thread>
+
+
+namespace
+{
+    // Below this many lanes per thread, splitting an operation costs more than it saves
+    constexpr std::size_t RNS_THREAD_MIN = 1 << 14;
+
+    // Primes per leaf of the limb subproduct tree; below this a word-by-word remainder is cheaper
+    constexpr std::size_t RNS_LEAF_PRIMES = 16;
+
+    uint32_t pow_mod(uint64_t b, uint32_t e, uint32_t m)
+    {
+        uint64_t r = 1;
+
+        for (b %= m; e; e >>= 1)
+        {
+            if (e & 1) {
+                r = r * b % m;
+            }
+            b = b * b % m;
+        }
+        return static_cast<uint32_t>(r);
+    }
+
+    // Deterministic Miller-Rabin; bases 2, 7 and 61 cover every n < 2^32
+    bool is_prime(uint32_t n)
+    {
+        if (n < 2) {
+            return false;
+        }
+        for (uint32_t q : { 2u, 3u, 5u, 7u, 61u })
+        {
+            if (n % q == 0) {
+                return n == q;
+            }
+        }
+        uint32_t d = n - 1;
+        int s = 0;
+
+        while (!(d & 1))
+        {
+            d >>= 1;
+            ++s;
+        }
+        for (uint32_t a : { 2u, 7u, 61u })
+        {
+            uint64_t x = pow_mod(a, d, n);
+
+            if (x == 1 || x == n - 1) {
+                continue;
+            }
+            bool composite = true;
+
+            for (int i = 1; i < s && composite; ++i)
+            {
+                x = x * x % n;
+                composite = (x != n - 1);
+            }
+            if (composite) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<uint32_t> largest_primes(std::size_t bits)
+    {
+        std::vector<uint32_t> primes;
+
+        // M must exceed 2^(bits + 1) so that the symmetric range holds |x| < 2^bits
+        double have = 0;
+
+        for (uint32_t n = (1u << 31) - 1; have < static_cast<double>(bits) + 2; n -= 2)
+        {
+            if (is_prime(n))
+            {
+                primes.push_back(n);
+                have += std::log2(static_cast<double>(n));
+            }
+        }
+        return primes;
+    }
+
+    std::vector<BigInteger> checked_moduli(const std::vector<uint32_t> &primes)
+    {
+        std::vector<uint32_t> sorted = primes;
+
+        std::sort(sorted.begin(), sorted.end());
+
+        if (sorted.empty() || std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+            throw std::invalid_argument("Arithmetic Error: RnsBasis requires distinct primes.");
+        }
+        std::vector<BigInteger> moduli;
+
+        moduli.reserve(primes.size());
+
+        for (uint32_t q : primes)
+        {
+            if (q < 3 || q >= (1u << 31) || !is_prime(q)) {
+                throw std::invalid_argument("Arithmetic Error: RnsBasis requires odd primes below 2^31.");
+            }
+            moduli.emplace_back(static_cast<int64_t>(q));
+        }
+        return moduli;
+    }
+
+    // Runs f(lo, hi) over [0, n), split into contiguous chunks across up to `threads` threads
+    template <typename F>
+    void for_lanes(std::size_t n, unsigned threads, F f)
+    {
+        std::size_t chunks = std::min<std::size_t>(threads, n / RNS_THREAD_MIN);
+
+        if (chunks <= 1)
+        {
+            f(static_cast<std::size_t>(0), n);
+            return;
+        }
+        std::vector<std::future<void>> pending;
+
+        for (std::size_t c = 1; c < chunks; ++c) {
+            pending.push_back(std::async(std::launch::async, f, n * c / chunks, n * (c + 1) / chunks));
+        }
+        f(static_cast<std::size_t>(0), n / chunks);
+
+        for (auto &job : pending) {
+            job.get();
+        }
+    }
+
+    // x mod m; Barrett's estimate needs x below B^2k for a modulus of k limbs, which holds below the
+    // root unless the tree is lopsided
+    Limbs::Natural reduce_node(const Limbs::Natural &x, const Limbs::Barrett &m)
+    {
+        const Limbs::Natural &n = m.modulus();
+
+        return (x.size() <= 2 * n.size() ? m.reduce(x) : Limbs::mod(x, n));
+    }
+
+    void check_basis(const RnsInteger &a, const RnsInteger &b)
+    {
+        if (a.get_basis() != b.get_basis() && a.get_basis()->primes() != b.get_basis()->primes()) {
+            throw std::invalid_argument("Arithmetic Error: RnsInteger operands use different bases.");
+        }
+    }
+}
+
+
+/* * * * * * * * * * * Basis * * * * * * * * * * */
+
+RnsBasis::RnsBasis(std::size_t bits, unsigned threads) : RnsBasis(largest_primes(bits), threads) {}
+
+RnsBasis::RnsBasis(const std::vector<uint32_t> &primes, unsigned threads)
+        : p(primes), crt(checked_moduli(primes)), half(crt.product() / BigConstants::TWO),
+          workers(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+{
+    width.reserve(p.size());
+    mu.reserve(p.size());
+
+    for (uint32_t q : p)
+    {
+        const auto s = static_cast<uint32_t>(std::bit_width(q));
+
+        width.push_back(s);
+        mu.push_back((static_cast<uint64_t>(1) << (2 * s)) / q);
+    }
+    std::vector<Limbs::Natural> level;
+
+    for (std::size_t i = 0; i < p.size(); i += RNS_LEAF_PRIMES)
+    {
+        Limbs::Natural leaf = { 1 };
+
+        for (std::size_t j = i; j < std::min(i + RNS_LEAF_PRIMES, p.size()); ++j) {
+            leaf = Limbs::mul_small(leaf, p[j]);
+        }
+        level.push_back(std::move(leaf));
+    }
+    for (;;)
+    {
+        tree.emplace_back(level.begin(), level.end());
+
+        if (level.size() == 1) {
+            break;
+        }
+        std::vector<Limbs::Natural> next;
+
+        next.reserve((level.size() + 1) / 2);
+
+        for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+            next.push_back(Limbs::mul(level[i], level[i + 1]));
+        }
+        if (level.size() % 2) {
+            next.push_back(level.back());
+        }
+        level = std::move(next);
+    }
+}
+
+std::vector<uint32_t> RnsBasis::to_residues(const BigInteger &x) const
+{
+    // Remainder tree over the limbs of |x|, down to the leaves; each prime then takes a single-word
+    // remainder of its leaf's value, so no lane goes through a decimal BigInteger
+    std::vector<Limbs::Natural> rems = { reduce_node(x.limbs(), tree.back().front()) };
+
+    for (std::size_t j = tree.size() - 1; j-- > 0;)
+    {
+        std::vector<Limbs::Natural> next(tree[j].size());
+
+        for (std::size_t i = 0; i < tree[j].size(); ++i) {
+            next[i] = reduce_node(rems[i / 2], tree[j][i]);
+        }
+        rems = std::move(next);
+    }
+    const bool negative = x < BigConstants::ZERO;
+    std::vector<uint32_t> r(p.size());
+
+    for (std::size_t i = 0; i < p.size(); ++i)
+    {
+        const uint32_t v = Limbs::mod_small(rems[i / RNS_LEAF_PRIMES], p[i]);
+
+        r[i] = (negative && v ? p[i] - v : v);
+    }
+    return r;
+}
+
+BigInteger RnsBasis::to_integer(const std::vector<uint32_t> &residues) const
+{
+    std::vector<BigInteger> rems;
+
+    rems.reserve(residues.size());
+
+    for (uint32_t r : residues) {
+        rems.emplace_back(static_cast<int64_t>(r));
+    }
+    BigInteger x = crt.reconstruct(rems);
+
+    if (x > half) {
+        x -= crt.product();
+    }
+    return x;
+}
+
+/* * * * * * * * * * * Constructors * * * * * * * * * * */
+
+RnsInteger::RnsInteger(std::shared_ptr<const RnsBasis> b, std::vector<uint32_t> r)
+        : basis(std::move(b)), residues(std::move(r)) {}
+
+RnsInteger::RnsInteger(const BigInteger &x, std::shared_ptr<const RnsBasis> b) : basis(std::move(b))
+{
+    if (!basis) {
+        throw std::invalid_argument("Arithmetic Error: RnsInteger requires a basis.");
+    }
+    residues = basis->to_residues(x);
+}
+
+BigInteger RnsInteger::to_integer() const {
+    return basis->to_integer(residues);
+}
+
+/* * * * * * * * * * * Lane arithmetic * * * * * * * * * * */
+
+// The lane loops are branch-free, and products are reduced by Barrett's method instead of a division,
+// so that the compiler can vectorise all three; the product loop needs per-lane 64-bit shifts, which on
+// x86 means AVX2.
+
+RnsInteger &operator += (RnsInteger &a, const RnsInteger &b)
+{
+    check_basis(a, b);
+
+    const uint32_t *p = a.basis->primes().data();
+    const uint32_t *y = b.residues.data();
+    uint32_t *x = a.residues.data();
+
+    for_lanes(a.residues.size(), a.basis->threads(), [=](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            uint32_t s = x[i] + y[i];
+
+            x[i] = s >= p[i] ? s - p[i] : s;
+        }
+    });
+    return a;
+}
+
+RnsInteger &operator -= (RnsInteger &a, const RnsInteger &b)
+{
+    check_basis(a, b);
+
+    const uint32_t *p = a.basis->primes().data();
+    const uint32_t *y = b.residues.data();
+    uint32_t *x = a.residues.data();
+
+    for_lanes(a.residues.size(), a.basis->threads(), [=](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            uint32_t d = x[i] + (p[i] - y[i]);
+
+            x[i] = d >= p[i] ? d - p[i] : d;
+        }
+    });
+    return a;
+}
+
+RnsInteger &operator *= (RnsInteger &a, const RnsInteger &b)
+{
+    check_basis(a, b);
+
+    const uint32_t *p = a.basis->primes().data();
+    const uint32_t *w = a.basis->widths().data();
+    const uint64_t *mu = a.basis->reciprocals().data();
+    const uint32_t *y = b.residues.data();
+    uint32_t *x = a.residues.data();
+
+    // For t < p^2 < 4^s, q = floor(floor(t / 2^(s-1)) mu / 2^(s+1)) is at most two below t / p, and
+    // every intermediate fits in 64 bits since s <= 31
+    for_lanes(a.residues.size(), a.basis->threads(), [=](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            const uint64_t t = static_cast<uint64_t>(x[i]) * y[i];
+            const uint64_t q = ((t >> (w[i] - 1)) * mu[i]) >> (w[i] + 1);
+
+            uint64_t r = t - q * p[i];
+
+            r = r >= p[i] ? r - p[i] : r;
+            r = r >= p[i] ? r - p[i] : r;
+            x[i] = static_cast<uint32_t>(r);
+        }
+    });
+    return a;
+}
+
+RnsInteger operator + (const RnsInteger &a, const RnsInteger &b)
+{
+    RnsInteger temp(a);
+    return temp += b;
+}
+
+RnsInteger operator - (const RnsInteger &a, const RnsInteger &b)
+{
+    RnsInteger temp(a);
+    return temp -= b;
+}
+
+RnsInteger operator * (const RnsInteger &a, const RnsInteger &b)
+{
+    RnsInteger temp(a);
+    return temp *= b;
+}
+
+RnsInteger operator - (const RnsInteger &a)
+{
+    std::vector<uint32_t> r(a.residues.size());
+    const std::vector<uint32_t> &p = a.basis->primes();
+
+    for (std::size_t i = 0; i < r.size(); ++i) {
+        r[i] = a.residues[i] ? p[i] - a.residues[i] : 0;
+    }
+    return { a.basis, std::move(r) };
+}
+
+bool operator == (const RnsInteger &a, const RnsInteger &b)
+{
+    check_basis(a, b);
+    return a.residues == b.residues;
+}
+
+bool operator != (const RnsInteger &a, const RnsInteger &b) {
+    return !(a == b);
+}
@@ -0,0 +1,101 @@
+#ifndef BIGINTEGER_RNSINTEGER_H
+#define BIGINTEGER_RNSINTEGER_H
+
+#include "BigInteger.h"
+#include "CrtContext.h"
+#include "Limbs.h"
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+
+/*
+ * A set of distinct word-sized primes p_0 .. p_{k-1} below 2^31 and their CRT context.
+ *
+ * An RnsInteger over the basis stores x mod p_i for every i; a value is recovered exactly as long as
+ * every intermediate result satisfies |x| < M / 2, M = p_0 * ... * p_{k-1}.
+ */
+class RnsBasis
+{
+private:
+    std::vector<uint32_t> p;
+
+    // Barrett constants per prime: width[i] is the bit length s of p_i and mu[i] = floor(4^s / p_i)
+    std::vector<uint32_t> width;
+    std::vector<uint64_t> mu;
+
+    // Subproduct tree of the primes in base 2^32, with the Barrett reciprocal of every node; each leaf
+    // is the product of a small group of primes
+    std::vector<std::vector<Limbs::Barrett>> tree;
+
+    CrtContext crt;
+
+    BigInteger half;
+
+    unsigned workers;
+
+public:
+    // The largest primes below 2^31, enough of them for |x| < 2^bits; threads = 0 uses every hardware thread
+    explicit RnsBasis(std::size_t bits, unsigned threads = 1);
+
+    // Requires distinct primes in [3, 2^31)
+    explicit RnsBasis(const std::vector<uint32_t> &primes, unsigned threads = 1);
+
+    const std::vector<uint32_t> &primes() const { return p; }
+
+    const std::vector<uint32_t> &widths() const { return width; }
+
+    const std::vector<uint64_t> &reciprocals() const { return mu; }
+
+    std::size_t size() const { return p.size(); }
+
+    const BigInteger &product() const { return crt.product(); }
+
+    unsigned threads() const { return workers; }
+
+    // Residues of x, and the x in (-M/2, M/2] with the given residues
+    std::vector<uint32_t> to_residues(const BigInteger &x) const;
+    BigInteger to_integer(const std::vector<uint32_t> &residues) const;
+};
+
+
+/*
+ * Residue number system integer: add, sub and mul work lane by lane with no carries, each lane a
+ * word-sized modular operation, and large bases spread the lanes over the basis' threads.
+ * Converting back to a BigInteger costs one CRT reconstruction.
+ */
+class RnsInteger
+{
+private:
+    std::shared_ptr<const RnsBasis> basis;
+
+    std::vector<uint32_t> residues;
+
+    RnsInteger(std::shared_ptr<const RnsBasis>, std::vector<uint32_t>);
+
+public:
+    RnsInteger(const BigInteger &, std::shared_ptr<const RnsBasis>);
+
+    const std::shared_ptr<const RnsBasis> &get_basis() const { return basis; }
+
+    const std::vector<uint32_t> &get_residues() const { return residues; }
+
+    BigInteger to_integer() const;
+
+    // Operands must share one basis
+    friend RnsInteger &operator += (RnsInteger &, const RnsInteger &);
+    friend RnsInteger &operator -= (RnsInteger &, const RnsInteger &);
+    friend RnsInteger &operator *= (RnsInteger &, const RnsInteger &);
+
+    friend RnsInteger operator + (const RnsInteger &, const RnsInteger &);
+    friend RnsInteger operator - (const RnsInteger &, const RnsInteger &);
+    friend RnsInteger operator * (const RnsInteger &, const RnsInteger &);
+
+    friend RnsInteger operator - (const RnsInteger &);
+
+    friend bool operator == (const RnsInteger &, const RnsInteger &);
+    friend bool operator != (const RnsInteger &, const RnsInteger &);
+};
+
+#endif //BIGINTEGER_RNSINTEGER_H
@@ -0,0 +1,101 @@
+#include "Series.h"
+
+#include <future>
+#include <thread>
+
+
+namespace
+{
+    // Below this many terms a subtree is not worth a thread of its own
+    constexpr int64_t SPLIT_THREAD_MIN = 256;
+
+    unsigned thread_count(unsigned threads) {
+        return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Appends `right` to `left`: T = B2 Q2 T1 + B1 P1 T2. The product of p is only needed while more terms may
+    // follow, so the last merge of a sum skips it (need_p = false).
+    void merge(const Series &s, Series::Partial &left, const Series::Partial &right, bool need_p)
+    {
+        if (s.b)
+        {
+            left.T = left.T * (right.B * right.Q) + (left.B * left.P) * right.T;
+            left.B *= right.B;
+        }
+        else
+            left.T = left.T * right.Q + left.P * right.T;
+
+        left.Q *= right.Q;
+
+        if (need_p) {
+            left.P *= right.P;
+        }
+        left.terms += right.terms;
+    }
+
+    // Terms lo .. hi - 1, with T / (B Q) their sum divided by p(0) ... p(lo - 1) / (q(0) ... q(lo - 1))
+    Series::Partial split(const Series &s, int64_t lo, int64_t hi, bool need_p, unsigned threads)
+    {
+        if (hi - lo == 1)
+        {
+            Series::Partial leaf;
+
+            leaf.terms = 1;
+            leaf.P = s.p(lo);
+            leaf.Q = s.q(lo);
+
+            if (s.b) {
+                leaf.B = s.b(lo);
+            }
+            leaf.T = s.a(lo) * leaf.P;
+
+            return leaf;
+        }
+        const int64_t mid = lo + (hi - lo) / 2;
+
+        Series::Partial left;
+        Series::Partial right;
+
+        // The upper levels of the tree run their left halves concurrently
+        if (threads > 1 && hi - lo >= SPLIT_THREAD_MIN)
+        {
+            auto pending = std::async(std::launch::async, split, std::cref(s), lo, mid, true, threads / 2);
+
+            right = split(s, mid, hi, need_p, threads - threads / 2);
+            left = pending.get();
+        }
+        else
+        {
+            left = split(s, lo, mid, true, 1);
+            right = split(s, mid, hi, need_p, 1);
+        }
+        merge(s, left, right, need_p);
+
+        return left;
+    }
+}
+
+
+BigDecimal Series::sum(int64_t terms, std::size_t digits, unsigned threads) const
+{
+    if (terms <= 0) {
+        return {};
+    }
+    return value(split(*this, 0, terms, false, thread_count(threads)), digits);
+}
+
+void Series::extend(Partial &partial, int64_t terms, unsigned threads) const
+{
+    if (terms <= partial.terms) {
+        return;
+    }
+    merge(*this, partial, split(*this, partial.terms, terms, true, thread_count(threads)), true);
+}
+
+BigDecimal Series::value(const Partial &partial, std::size_t digits) const
+{
+    const BigDecimal denominator = (b ? BigDecimal::mul(BigDecimal(partial.B), BigDecimal(partial.Q), digits + 2)
+                                      : BigDecimal::round(BigDecimal(partial.Q), digits + 2));
+
+    return BigDecimal::div(BigDecimal::round(BigDecimal(partial.T), digits + 2), denominator, digits);
+}
@@ -0,0 +1,50 @@
+#ifndef BIGINTEGER_SERIES_H
+#define BIGINTEGER_SERIES_H
+
+#include "BigDecimal.h"
+
+#include <functional>
+
+
+/*
+ * Binary splitting evaluation of series whose consecutive terms have a rational ratio,
+ *
+ *     S = sum_{n = 0}^{N - 1}  a(n) / b(n) * (p(0) p(1) ... p(n)) / (q(0) q(1) ... q(n)),
+ *
+ * with small integers a, b, p and q. Ranges of terms are merged pairwise into exact integers P, Q, B and T
+ * with T / (B Q) the partial sum, so the cost is a few balanced products instead of N divisions at full
+ * precision. The upper levels of the tree run on separate threads, and a Partial sum can be extended by
+ * further terms later without splitting the earlier ones again.
+ */
+struct Series
+{
+    std::function<BigInteger(int64_t)> a;
+
+    // May be left empty for b(n) = 1
+    std::function<BigInteger(int64_t)> b;
+
+    std::function<BigInteger(int64_t)> p;
+    std::function<BigInteger(int64_t)> q;
+
+    // The first `terms` terms held exactly: P = p(0) ... p(terms - 1), Q and B likewise, and T / (B Q) their sum
+    struct Partial
+    {
+        int64_t terms = 0;
+
+        BigInteger P = BigConstants::ONE;
+        BigInteger Q = BigConstants::ONE;
+        BigInteger B = BigConstants::ONE;
+        BigInteger T = BigConstants::ZERO;
+    };
+
+    // Sum of the first `terms` terms to `digits` significant digits; threads = 0 uses every hardware thread
+    BigDecimal sum(int64_t terms, std::size_t digits, unsigned threads = 1) const;
+
+    // Appends the terms up to `terms` to a partial sum, splitting only the new ones
+    void extend(Partial &, int64_t terms, unsigned threads = 1) const;
+
+    // T / (B Q) to `digits` significant digits
+    BigDecimal value(const Partial &, std::size_t digits) const;
+};
+
+#endif //BIGINTEGER_SERIES_H
@@ -0,0 +1,70 @@
+#include <iostream>
+
+#include "BigDecimal.h"
+#include "BigRational.h"
+#include "RnsInteger.h"
+
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool passed, const char *what)
+    {
+        if (!passed)
+        {
+            std::cerr << "FAIL: " << what << '\n';
+            ++failures;
+        }
+    }
+}
+
+
+int main()
+{
+    // mod_2 returned 0 for odd values, so odd powers of negative bases lost their sign
+    check(BigInteger(7).mod_2() == BigConstants::ONE, "7 mod 2 == 1");
+    check((BigInteger(-2) ^ 3) == BigInteger(-8), "(-2)^3 == -8");
+
+    // Subtraction with |a| < |b| kept the sign of a, and cancelling sums could leave a negative zero
+    check(BigInteger(3) - BigInteger(5) == BigInteger(-2), "3 - 5 == -2");
+    check(BigInteger(-4) + BigInteger(4) == BigConstants::ZERO, "-4 + 4 == 0");
+    check(BigInteger(-4) - BigInteger(-4) == BigConstants::ZERO, "-4 - -4 == 0");
+
+    // Two negatives were ordered by magnitude
+    check(BigInteger(-5) < BigInteger(-3), "-5 < -3");
+    check(BigInteger(-3) > BigInteger(-5), "-3 > -5");
+    check(BigInteger(-30) < BigInteger(-5), "-30 < -5");
+
+    using Rounding = BigDecimal::Rounding;
+
+    // An operand far below the other must not carry into the kept digits through its stand-in unit
+    check(BigDecimal::add(BigDecimal("1.0000499999"), BigDecimal("1e-20"), 5, Rounding::HALF_EVEN) == BigDecimal("1.0000"),
+          "add(1.0000499999, 1e-20, 5, HALF_EVEN) == 1.0000");
+    check(BigDecimal::add(BigDecimal("1.0000999999"), BigDecimal("1e-20"), 5, Rounding::DOWN) == BigDecimal("1.0000"),
+          "add(1.0000999999, 1e-20, 5, DOWN) == 1.0000");
+    check(BigDecimal::sub(BigDecimal("1.0000500001"), BigDecimal("1e-20"), 5, Rounding::HALF_EVEN) == BigDecimal("1.0001"),
+          "sub(1.0000500001, 1e-20, 5, HALF_EVEN) == 1.0001");
+
+    // Nor may it be replaced at all while the other operand has digits below it
+    check(BigDecimal::add(BigDecimal("1.00000999999991"), BigDecimal("5.27e-12"), 6, Rounding::FLOOR) == BigDecimal("1.00001"),
+          "add(1.00000999999991, 5.27e-12, 6, FLOOR) == 1.00001");
+
+    // Residues come from a limb remainder tree and lane products from Barrett reduction, for any prime width
+    auto basis = std::make_shared<const RnsBasis>(std::vector<uint32_t>{ 3, 5, 7, 65537, 2147483647 });
+    RnsInteger x(BigInteger(-123456789), basis), y(BigInteger(987654), basis);
+
+    check((x * y).to_integer() == BigInteger(-123456789) * BigInteger(987654), "RNS -123456789 * 987654");
+    check((x - y).to_integer() == BigInteger(-124444443), "RNS -123456789 - 987654");
+
+    // A zero numerator kept a negative sign
+    check(BigRational(BigInteger("-0"), BigInteger(5)) == BigRational(), "-0/5 == 0");
+
+    std::string minus_zero = "-0/7";
+    BigRational z(minus_zero);
+
+    check(!z.is_negative(), "-0/7 is not negative");
+    check(z == BigRational() && z.toString() == "0", "-0/7 == 0 and prints 0");
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}